@@ -12,6 +12,7 @@
 #include <iostream>
 
 #include "util/asm.hpp"
+#include "util/atomic.hpp"
 #include "util/coro.hpp"
 
 using namespace std::literals::string_literals;
@@ -245,6 +246,11 @@ namespace fs
 		return {};
 	}
 
+	const u8* file_base::get_mapping()
+	{
+		return nullptr;
+	}
+
 	u64 file_base::write_gather(const iovec_clone* buffers, u64 buf_count)
 	{
 		u64 total = 0;
@@ -1164,6 +1170,37 @@ void fs::sync()
 #endif
 }
 
+bool fs::sync_dir(const std::string& path)
+{
+	if (get_virtual_device(path))
+	{
+		return true;
+	}
+
+#ifdef _WIN32
+	// Directory metadata is journaled by NTFS
+	return true;
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+	if (fd == -1)
+	{
+		g_tls_error = to_error(errno);
+		return false;
+	}
+
+	const bool result = ::fsync(fd) == 0;
+
+	if (!result)
+	{
+		g_tls_error = to_error(errno);
+	}
+
+	::close(fd);
+	return result;
+#endif
+}
+
 [[noreturn]] void fs::xnull(std::source_location loc)
 {
 	fmt::throw_exception("Null object.%s", loc);
@@ -1787,6 +1824,207 @@ fs::file_id fs::file::get_id() const
 	return {};
 }
 
+bool fs::file::map_readonly()
+{
+	class mapped_file final : public file_base
+	{
+		const std::unique_ptr<file_base> m_file; // Native file, used for stat and ID queries
+		const u8* const m_ptr;
+		const u64 m_size;
+		u64 m_pos;
+
+#ifdef _WIN32
+		const HANDLE m_map;
+#endif
+
+		atomic_t<u64> m_next{0}; // Expected offset of the next sequential read
+		atomic_t<s32> m_score{0}; // Positive for sequential access pattern
+		atomic_t<bool> m_random{false}; // Current access hint
+
+		void update_hint(u64 offset, u64 count)
+		{
+			const bool is_sequential = m_next.exchange(offset + count) == offset;
+
+			const s32 score = m_score.atomic_op([&](s32& v)
+			{
+				v = std::clamp(v + (is_sequential ? 1 : -4), -32, 32);
+				return v;
+			});
+
+			if (score <= -16 ? !m_random.exchange(true) : score >= 16 && m_random.exchange(false))
+			{
+#ifndef _WIN32
+				::madvise(const_cast<u8*>(m_ptr), m_size, score < 0 ? MADV_RANDOM : MADV_SEQUENTIAL);
+#endif
+			}
+		}
+
+	public:
+#ifdef _WIN32
+		mapped_file(std::unique_ptr<file_base>&& file, const u8* ptr, u64 size, u64 pos, HANDLE map)
+#else
+		mapped_file(std::unique_ptr<file_base>&& file, const u8* ptr, u64 size, u64 pos)
+#endif
+			: m_file(std::move(file))
+			, m_ptr(ptr)
+			, m_size(size)
+			, m_pos(pos)
+#ifdef _WIN32
+			, m_map(map)
+#endif
+		{
+		}
+
+		mapped_file(const mapped_file&) = delete;
+
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		~mapped_file() override
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(m_ptr);
+			CloseHandle(m_map);
+#else
+			::munmap(const_cast<u8*>(m_ptr), m_size);
+#endif
+		}
+
+		stat_t get_stat() override
+		{
+			return m_file->get_stat();
+		}
+
+		bool trunc(u64) override
+		{
+			return false;
+		}
+
+		u64 read(void* buffer, u64 count) override
+		{
+			const u64 result = read_at(m_pos, buffer, count);
+			m_pos += result;
+			return result;
+		}
+
+		u64 read_at(u64 offset, void* buffer, u64 count) override
+		{
+			if (offset >= m_size)
+			{
+				return 0;
+			}
+
+			const u64 result = std::min<u64>(count, m_size - offset);
+
+			update_hint(offset, result);
+			std::memcpy(buffer, m_ptr + offset, result);
+			return result;
+		}
+
+		u64 write(const void*, u64) override
+		{
+			return 0;
+		}
+
+		u64 seek(s64 offset, fs::seek_mode whence) override
+		{
+			const s64 new_pos =
+				whence == fs::seek_set ? offset :
+				whence == fs::seek_cur ? offset + m_pos :
+				whence == fs::seek_end ? offset + size() : -1;
+
+			if (new_pos < 0)
+			{
+				fs::g_tls_error = fs::error::inval;
+				return -1;
+			}
+
+			m_pos = new_pos;
+			return m_pos;
+		}
+
+		u64 size() override
+		{
+			return m_size;
+		}
+
+		native_handle get_handle() override
+		{
+			return m_file->get_handle();
+		}
+
+		file_id get_id() override
+		{
+			return m_file->get_id();
+		}
+
+		const u8* get_mapping() override
+		{
+			return m_ptr;
+		}
+	};
+
+	if (!m_file || m_file->get_mapping())
+	{
+		return false;
+	}
+
+	const native_handle handle = m_file->get_handle();
+	const u64 size = m_file->size();
+
+#ifdef _WIN32
+	if (handle == INVALID_HANDLE_VALUE || !size)
+	{
+		return false;
+	}
+
+	const HANDLE map = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!map)
+	{
+		g_tls_error = to_error(GetLastError());
+		return false;
+	}
+
+	const auto ptr = static_cast<const u8*>(MapViewOfFile(map, FILE_MAP_READ, 0, 0, size));
+
+	if (!ptr)
+	{
+		g_tls_error = to_error(GetLastError());
+		CloseHandle(map);
+		return false;
+	}
+
+	const u64 pos = m_file->seek(0, seek_cur);
+	m_file = std::make_unique<mapped_file>(std::move(m_file), ptr, size, pos, map);
+#else
+	if (handle == -1 || !size)
+	{
+		return false;
+	}
+
+	void* const ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, handle, 0);
+
+	if (ptr == MAP_FAILED)
+	{
+		g_tls_error = to_error(errno);
+		return false;
+	}
+
+	// Start with the sequential hint, switched by the observed access pattern
+	::madvise(ptr, size, MADV_SEQUENTIAL);
+
+	const u64 pos = m_file->seek(0, seek_cur);
+	m_file = std::make_unique<mapped_file>(std::move(m_file), static_cast<const u8*>(ptr), size, pos);
+#endif
+
+	return true;
+}
+
+const u8* fs::file::get_mapping() const
+{
+	return m_file ? m_file->get_mapping() : nullptr;
+}
+
 bool fs::dir::open(const std::string& path)
 {
 	m_dir.reset();
@@ -111,6 +111,7 @@ namespace fs
 		virtual native_handle get_handle();
 		virtual file_id get_id();
 		virtual u64 write_gather(const iovec_clone* buffers, u64 buf_count);
+		virtual const u8* get_mapping();
 	};
 
 	// Directory entry (TODO)
@@ -235,6 +236,9 @@ namespace fs
 	// Synchronize filesystems (TODO)
 	void sync();
 
+	// Flush directory entries (created, renamed or removed files) of a directory to disk
+	bool sync_dir(const std::string& path);
+
 	class file final
 	{
 		std::unique_ptr<file_base> m_file{};
@@ -459,6 +463,12 @@ namespace fs
 		// Get file ID information (custom ID)
 		file_id get_id() const;
 
+		// Replace native file opened for reading with read-only memory mapping of its contents
+		bool map_readonly();
+
+		// Get mapped contents if available (reading doesn't involve native API)
+		const u8* get_mapping() const;
+
 		// Gathered write
 		u64 write_gather(const iovec_clone* buffers, u64 buf_count, std::source_location src_loc = std::source_location::current()) const
 		{
@@ -7,9 +7,11 @@
 #include "Emu/Memory/vm.h"
 #include "Emu/System.h"
 #include "Emu/VFS.h"
+#include "Crypto/sha1.h"
 
 #include "util/types.hpp"
 #include "util/asm.hpp"
+#include "util/serialization.hpp"
 
 #include <charconv>
 #include <regex>
@@ -163,8 +165,234 @@ static void append_log_message(std::stringstream* log_messages, std::string_view
 	}
 };
 
+// Binary cache of parsed patch files (without patch config), avoids YAML parsing on every boot
+namespace patch_cache
+{
+	// Increment when the format or the parsing rules change
+	constexpr u32 cache_version = 1;
+
+	constexpr u64 cache_magic = "RPCSPTCH"_u64;
+
+	using hash_t = std::array<u8, 20>;
+
+	template <typename Map, typename F>
+	static void serialize_map(utils::serial& ar, Map& map, F&& func)
+	{
+		usz count = map.size();
+		ar(count);
+
+		if (ar.is_writing())
+		{
+			for (auto& [key, value] : map)
+			{
+				ar(key);
+				func(value);
+			}
+
+			return;
+		}
+
+		for (usz i = 0; i < count; i++)
+		{
+			std::string key;
+			ar(key);
+			func(map[std::move(key)]);
+		}
+	}
+
+	template <typename T, typename F>
+	static void serialize_vector(utils::serial& ar, std::vector<T>& vec, F&& func)
+	{
+		usz count = vec.size();
+		ar(count);
+
+		if (!ar.is_writing())
+		{
+			vec.resize(count);
+		}
+
+		for (T& value : vec)
+		{
+			func(value);
+		}
+	}
+
+	static void serialize_patches(utils::serial& ar, patch_engine::patch_map& patches)
+	{
+		serialize_map(ar, patches, [&](patch_engine::patch_container& container)
+		{
+			ar(container.hash, container.version);
+
+			serialize_map(ar, container.patch_info_map, [&](patch_engine::patch_info& info)
+			{
+				serialize_vector(ar, info.data_list, [&](patch_engine::patch_data& data)
+				{
+					ar(data.type, data.offset, data.original_offset, data.original_value, data.value.long_value);
+				});
+
+				// Patch config is not part of the cache, only the title/serial/app version keys are stored
+				serialize_map(ar, info.titles, [&](patch_engine::patch_serials& serials)
+				{
+					serialize_map(ar, serials, [&](patch_engine::patch_app_versions& app_versions)
+					{
+						serialize_map(ar, app_versions, [](patch_engine::patch_config_values&) {});
+					});
+				});
+
+				ar(info.description, info.patch_version, info.patch_group, info.author, info.notes, info.source_path, info.hash, info.version);
+
+				serialize_map(ar, info.default_config_values, [&](patch_engine::patch_config_value& value)
+				{
+					ar(value.value, value.min, value.max, value.type);
+
+					serialize_vector(ar, value.allowed_values, [&](patch_engine::patch_allowed_value& allowed)
+					{
+						ar(allowed.label, allowed.value);
+					});
+				});
+			});
+		});
+	}
+
+	static std::string get_path(std::string_view path)
+	{
+		return fs::get_cache_dir() + "patches/" + std::string(path.substr(path.find_last_of(fs::delim) + 1)) + ".bin";
+	}
+
+	// Returns true and fills the map if the cache matches the file contents
+	static bool load(const std::string& path, const hash_t& content_hash, patch_engine::patch_map& patches, bool& is_valid)
+	{
+		fs::file cache_file(get_path(path));
+
+		if (!cache_file || cache_file.size() < sizeof(hash_t))
+		{
+			return false;
+		}
+
+		std::vector<u8> data = cache_file.to_vector<u8>();
+
+		// Verify integrity of the cache before deserializing anything
+		hash_t data_hash{};
+		sha1(data.data() + sizeof(hash_t), data.size() - sizeof(hash_t), data_hash.data());
+
+		if (std::memcmp(data.data(), data_hash.data(), sizeof(hash_t)) != 0)
+		{
+			return false;
+		}
+
+		utils::serial ar;
+		ar.set_reading_state(std::move(data));
+		ar.pos = sizeof(hash_t);
+
+		const u64 magic = ar;
+		const u32 version = ar;
+		const std::string engine_version = ar;
+		const std::string source_path = ar;
+		const hash_t source_hash = ar;
+
+		if (magic != cache_magic || version != cache_version || engine_version != patch_engine_version || source_path != path || source_hash != content_hash)
+		{
+			return false;
+		}
+
+		ar(is_valid);
+		serialize_patches(ar, patches);
+		return true;
+	}
+
+	static void save(const std::string& path, const hash_t& content_hash, patch_engine::patch_map& patches, bool is_valid)
+	{
+		utils::serial ar;
+		ar(hash_t{}, cache_magic, cache_version, patch_engine_version, path, content_hash, is_valid);
+		serialize_patches(ar, patches);
+
+		// Integrity hash of the contents
+		sha1(ar.data.data() + sizeof(hash_t), ar.data.size() - sizeof(hash_t), ar.data.data());
+
+		const std::string cache_path = get_path(path);
+
+		if (!fs::create_path(fs::get_parent_dir(cache_path)))
+		{
+			patch_log.error("Failed to create patch cache directory for %s (%s)", path, fs::g_tls_error);
+			return;
+		}
+
+		fs::pending_file cache_file(cache_path);
+
+		if (!cache_file.file || cache_file.file.write(ar.data.data(), ar.data.size()) != ar.data.size() || !cache_file.commit())
+		{
+			patch_log.error("Failed to write patch cache %s (%s)", cache_path, fs::g_tls_error);
+		}
+	}
+}
+
+// Merge the patches of one file into the patches map and apply the patch config
+static bool merge_patches(patch_engine::patch_map& patches_map, patch_engine::patch_map&& new_patches, const std::string& path, bool importing, std::stringstream* log_messages, bool is_valid)
+{
+	// Load patch config to determine which patches are enabled
+	patch_engine::patch_map patch_config;
+
+	if (!importing)
+	{
+		patch_config = patch_engine::load_config();
+	}
+
+	for (auto& [main_key, new_container] : new_patches)
+	{
+		// Find or create an entry matching the key/hash in our map
+		patch_engine::patch_container& container = patches_map[main_key];
+		container.hash    = main_key;
+		container.version = new_container.version;
+
+		for (auto& [description, info] : new_container.patch_info_map)
+		{
+			if (!importing)
+			{
+				// Get this patch's config values
+				for (auto& [title, serials] : info.titles)
+				{
+					for (auto& [serial, app_versions] : serials)
+					{
+						for (auto& [app_version, config_values] : app_versions)
+						{
+							config_values = patch_config[main_key].patch_info_map[description].titles[title][serial][app_version];
+						}
+					}
+				}
+			}
+
+			// Skip this patch if a higher patch version already exists
+			if (container.patch_info_map.contains(description))
+			{
+				bool ok;
+				const std::string& existing_version = container.patch_info_map[description].patch_version;
+				const bool version_is_bigger = utils::compare_versions(info.patch_version, existing_version, ok) > 0;
+
+				if (!ok || !version_is_bigger)
+				{
+					append_log_message(log_messages, fmt::format("A higher or equal patch version already exists ('%s' vs '%s') for %s: %s (in file %s)", info.patch_version, existing_version, main_key, description, path), &patch_log.warning);
+					continue;
+				}
+
+				if (!importing)
+				{
+					patch_log.warning("A lower patch version was found ('%s' vs '%s') for %s: %s (in file %s)", existing_version, info.patch_version, main_key, description,  container.patch_info_map[description].source_path);
+				}
+			}
+
+			// Insert patch information
+			container.patch_info_map[description] = std::move(info);
+		}
+	}
+
+	return is_valid;
+}
+
 bool patch_engine::load(patch_map& patches_map, const std::string& path, std::string content, bool importing, std::stringstream* log_messages)
 {
+	// Only plain loads of patch files are cached (the UI needs the parser's messages)
+	const bool use_cache = content.empty() && !importing && !log_messages;
+
 	if (content.empty())
 	{
 		// Load patch file
@@ -179,6 +407,23 @@ bool patch_engine::load(patch_map& patches_map, const std::string& path, std::st
 		content = file.to_string();
 	}
 
+	patch_cache::hash_t content_hash{};
+
+	if (use_cache)
+	{
+		sha1(reinterpret_cast<const u8*>(content.data()), content.size(), content_hash.data());
+
+		patch_map cached_patches;
+
+		if (bool is_valid = true; patch_cache::load(path, content_hash, cached_patches, is_valid))
+		{
+			return merge_patches(patches_map, std::move(cached_patches), path, importing, log_messages, is_valid);
+		}
+	}
+
+	// Patches of this file, merged into the patches map at the end
+	patch_map new_patches;
+
 	// Interpret yaml nodes
 	auto [root, error] = yaml_load(content);
 
@@ -189,14 +434,6 @@ bool patch_engine::load(patch_map& patches_map, const std::string& path, std::st
 		return false;
 	}
 
-	// Load patch config to determine which patches are enabled
-	patch_map patch_config;
-
-	if (!importing)
-	{
-		patch_config = load_config();
-	}
-
 	std::string version;
 
 	if (const auto version_node = root[patch_key::version])
@@ -246,7 +483,7 @@ bool patch_engine::load(patch_map& patches_map, const std::string& path, std::st
 		}
 
 		// Find or create an entry matching the key/hash in our map
-		patch_container& container = patches_map[main_key];
+		patch_container& container = new_patches[main_key];
 		container.hash    = main_key;
 		container.version = version;
 
@@ -369,10 +606,8 @@ bool patch_engine::load(patch_map& patches_map, const std::string& path, std::st
 								continue;
 							}
 
-							// Get this patch's config values
-							const patch_config_values& config_values = patch_config[main_key].patch_info_map[description].titles[title][serial][app_version];
-
-							app_versions[app_version] = config_values;
+							// Config values are applied when merging
+							app_versions[app_version] = {};
 						}
 
 						if (app_versions.empty())
@@ -656,7 +891,12 @@ bool patch_engine::load(patch_map& patches_map, const std::string& path, std::st
 		}
 	}
 
-	return is_valid;
+	if (use_cache)
+	{
+		patch_cache::save(path, content_hash, new_patches, is_valid);
+	}
+
+	return merge_patches(patches_map, std::move(new_patches), path, importing, log_messages, is_valid);
 }
 
 patch_type patch_engine::get_patch_type(std::string_view text)
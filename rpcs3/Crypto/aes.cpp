@@ -863,6 +863,11 @@ int aes_crypt_ctr( aes_context *ctx,
     int c, i;
     size_t n = *nc_off;
 
+#if defined(__SSE2__) || defined(_M_X64)
+    if( aesni_supports( POLARSSL_AESNI_AES ) )
+        return( aesni_crypt_ctr( ctx, length, nc_off, nonce_counter, stream_block, input, output ) );
+#endif
+
     while( length-- )
     {
         if( n == 0 ) {
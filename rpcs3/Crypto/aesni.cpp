@@ -35,6 +35,10 @@
 #if defined(_MSC_VER) && defined(_M_X64)
 #define POLARSSL_HAVE_MSVC_X64_INTRINSICS
 #include <intrin.h>
+#define AESNI_TARGET
+#else
+#include <immintrin.h>
+#define AESNI_TARGET __attribute__((__target__("aes")))
 #endif
 
 /*
@@ -683,4 +687,100 @@ int aesni_setkey_enc( unsigned char *rk,
     return( 0 );
 }
 
+/*
+ * Increment the 128-bit big-endian counter
+ */
+static inline void aesni_ctr_increment( unsigned char nonce_counter[16] )
+{
+    for( int i = 16; i > 0; i-- )
+        if( ++nonce_counter[i - 1] != 0 )
+            break;
+}
+
+/*
+ * Encrypt 4 counter blocks at once (interleaved to hide aesenc latency)
+ */
+AESNI_TARGET static inline void aesni_ctr_encrypt4( const aes_context *ctx, __m128i b[4] )
+{
+    const __m128i* rk = reinterpret_cast<const __m128i*>( ctx->rk );
+    __m128i k = _mm_loadu_si128( rk++ );
+
+    for( int j = 0; j < 4; j++ )
+        b[j] = _mm_xor_si128( b[j], k );
+
+    for( int i = ctx->nr - 1; i; --i )
+    {
+        k = _mm_loadu_si128( rk++ );
+
+        for( int j = 0; j < 4; j++ )
+            b[j] = _mm_aesenc_si128( b[j], k );
+    }
+
+    k = _mm_loadu_si128( rk );
+
+    for( int j = 0; j < 4; j++ )
+        b[j] = _mm_aesenclast_si128( b[j], k );
+}
+
+/*
+ * AES-NI AES-CTR buffer encryption/decryption
+ */
+AESNI_TARGET int aesni_crypt_ctr( aes_context *ctx,
+                                  size_t length,
+                                  size_t *nc_off,
+                                  unsigned char nonce_counter[16],
+                                  unsigned char stream_block[16],
+                                  const unsigned char *input,
+                                  unsigned char *output )
+{
+    size_t n = *nc_off;
+
+    // Use up the remainder of the saved stream block
+    while( n != 0 && length != 0 )
+    {
+        *output++ = static_cast<unsigned char>( *input++ ^ stream_block[n] );
+        n = (n + 1) & 0x0F;
+        length--;
+    }
+
+    while( length != 0 )
+    {
+        __m128i b[4]{}; // Unused lanes of the final group are encrypted as zero
+        int blocks = 0;
+
+        for( ; blocks < 4 && static_cast<size_t>( blocks ) * 16 < length; blocks++ )
+        {
+            b[blocks] = _mm_loadu_si128( reinterpret_cast<const __m128i*>( nonce_counter ) );
+            aesni_ctr_increment( nonce_counter );
+        }
+
+        aesni_ctr_encrypt4( ctx, b );
+
+        for( int j = 0; j < blocks; j++ )
+        {
+            if( length >= 16 )
+            {
+                const __m128i in = _mm_loadu_si128( reinterpret_cast<const __m128i*>( input ) );
+                _mm_storeu_si128( reinterpret_cast<__m128i*>( output ), _mm_xor_si128( in, b[j] ) );
+                input += 16;
+                output += 16;
+                length -= 16;
+                continue;
+            }
+
+            // Partial block: keep the stream block for resuming
+            _mm_storeu_si128( reinterpret_cast<__m128i*>( stream_block ), b[j] );
+
+            for( ; n < length; n++ )
+                output[n] = static_cast<unsigned char>( input[n] ^ stream_block[n] );
+
+            length = 0;
+        }
+    }
+
+    *nc_off = n;
+
+    return( 0 );
+}
+
 #endif
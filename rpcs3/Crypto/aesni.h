@@ -98,6 +98,28 @@ int aesni_setkey_enc( unsigned char *rk,
                       const unsigned char *key,
                       size_t bits );
 
+/**
+ * \brief           AES-NI AES-CTR buffer encryption/decryption
+ *                  (same interface as aes_crypt_ctr, processes 4 blocks at once)
+ *
+ * \param ctx       AES context (set up with aes_setkey_enc)
+ * \param length    The length of the data
+ * \param nc_off    The offset in the current stream_block
+ * \param nonce_counter The 128-bit nonce and counter
+ * \param stream_block  The saved stream-block for resuming
+ * \param input     The input data stream
+ * \param output    The output data stream (may be equal to input)
+ *
+ * \return          0 on success (cannot fail)
+ */
+int aesni_crypt_ctr( aes_context *ctx,
+                     size_t length,
+                     size_t *nc_off,
+                     unsigned char nonce_counter[16],
+                     unsigned char stream_block[16],
+                     const unsigned char *input,
+                     unsigned char *output );
+
 #ifdef __cplusplus
 }
 #endif
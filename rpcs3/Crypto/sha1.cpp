@@ -30,6 +30,17 @@
 
 #include "sha1.h"
 #include "utils.h"
+#include "util/sysinfo.hpp"
+
+#if defined(ARCH_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SHANI_TARGET
+#else
+#include <immintrin.h>
+#define SHANI_TARGET __attribute__((__target__("sha,sse4.1")))
+#endif
+#endif
 
 /*
  * 32-bit integer manipulation macros (big endian)
@@ -225,6 +236,87 @@ void sha1_process( sha1_context *ctx, const unsigned char data[64] )
     ctx->state[4] += E;
 }
 
+#if defined(ARCH_X64)
+/*
+ * SHA-NI: 4 rounds per step, the message schedule runs 3 steps ahead
+ */
+template <int I>
+SHANI_TARGET static inline void sha1_shani_step( __m128i& abcd, __m128i& e0, __m128i& e1, __m128i msg[4] )
+{
+    __m128i& e = I % 2 ? e1 : e0;
+    __m128i& next = I % 2 ? e0 : e1;
+
+    if constexpr ( I == 0 )
+        e = _mm_add_epi32( e, msg[0] );
+    else
+        e = _mm_sha1nexte_epu32( e, msg[I % 4] );
+
+    next = abcd;
+
+    if constexpr ( I >= 3 && I <= 18 )
+        msg[(I + 1) % 4] = _mm_sha1msg2_epu32( msg[(I + 1) % 4], msg[I % 4] );
+
+    abcd = _mm_sha1rnds4_epu32( abcd, e, I / 5 );
+
+    if constexpr ( I >= 1 && I <= 16 )
+        msg[(I + 3) % 4] = _mm_sha1msg1_epu32( msg[(I + 3) % 4], msg[I % 4] );
+
+    if constexpr ( I >= 2 && I <= 17 )
+        msg[(I + 2) % 4] = _mm_xor_si128( msg[(I + 2) % 4], msg[I % 4] );
+}
+
+template <int... I>
+SHANI_TARGET static inline void sha1_shani_steps( __m128i& abcd, __m128i& e0, __m128i& e1, __m128i msg[4], std::integer_sequence<int, I...> )
+{
+    ( sha1_shani_step<I>( abcd, e0, e1, msg ), ... );
+}
+
+SHANI_TARGET static void sha1_process_shani( uint32_t state[5], const unsigned char *data, size_t blocks )
+{
+    const __m128i mask = _mm_set_epi64x( 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL );
+
+    __m128i abcd = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( state ) ), 0x1B );
+    __m128i e0 = _mm_set_epi32( static_cast<int>( state[4] ), 0, 0, 0 );
+    __m128i e1 = _mm_setzero_si128();
+
+    for( ; blocks; blocks--, data += 64 )
+    {
+        const __m128i abcd_save = abcd;
+        const __m128i e0_save = e0;
+
+        __m128i msg[4];
+
+        for( int i = 0; i < 4; i++ )
+            msg[i] = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + i * 16 ) ), mask );
+
+        sha1_shani_steps( abcd, e0, e1, msg, std::make_integer_sequence<int, 20>{} );
+
+        e0 = _mm_sha1nexte_epu32( e0, e0_save );
+        abcd = _mm_add_epi32( abcd, abcd_save );
+    }
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( state ), _mm_shuffle_epi32( abcd, 0x1B ) );
+    state[4] = static_cast<uint32_t>( _mm_extract_epi32( e0, 3 ) );
+}
+#endif
+
+/*
+ * Process a number of consecutive 64-byte blocks
+ */
+static void sha1_process_blocks( sha1_context *ctx, const unsigned char *data, size_t blocks )
+{
+#if defined(ARCH_X64)
+    if( utils::has_sha() )
+    {
+        sha1_process_shani( ctx->state, data, blocks );
+        return;
+    }
+#endif
+
+    for( ; blocks; blocks--, data += 64 )
+        sha1_process( ctx, data );
+}
+
 /*
  * SHA-1 process buffer
  */
@@ -249,17 +341,17 @@ void sha1_update( sha1_context *ctx, const unsigned char *input, size_t ilen )
     if( left && ilen >= fill )
     {
         memcpy( ctx->buffer + left, input, fill );
-        sha1_process( ctx, ctx->buffer );
+        sha1_process_blocks( ctx, ctx->buffer, 1 );
         input += fill;
         ilen  -= fill;
         left = 0;
     }
 
-    while( ilen >= 64 )
+    if( ilen >= 64 )
     {
-        sha1_process( ctx, input );
-        input += 64;
-        ilen  -= 64;
+        sha1_process_blocks( ctx, input, ilen / 64 );
+        input += ilen & ~size_t{63};
+        ilen  &= 63;
     }
 
     if( ilen > 0 )
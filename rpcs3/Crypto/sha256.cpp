@@ -28,9 +28,20 @@
 
 #include "sha256.h"
 #include "utils.h"
+#include "util/sysinfo.hpp"
 
 #include <string.h>
 
+#if defined(ARCH_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SHANI_TARGET
+#else
+#include <immintrin.h>
+#define SHANI_TARGET __attribute__((__target__("sha,sse4.1")))
+#endif
+#endif
+
 #if defined(MBEDTLS_SELF_TEST)
 #if defined(MBEDTLS_PLATFORM_C)
 #include "mbedtls/platform.h"
@@ -261,6 +272,93 @@ void mbedtls_sha256_process( mbedtls_sha256_context *ctx,
 #endif
 #endif /* !MBEDTLS_SHA256_PROCESS_ALT */
 
+#if defined(ARCH_X64) && !defined(MBEDTLS_SHA256_PROCESS_ALT)
+/*
+ * SHA-NI: 4 rounds per step, the message schedule runs 3 steps ahead
+ */
+template <int I>
+SHANI_TARGET static inline void sha256_shani_step( __m128i& abef, __m128i& cdgh, __m128i msg[4] )
+{
+    __m128i tmp = _mm_add_epi32( msg[I % 4], _mm_loadu_si128( reinterpret_cast<const __m128i*>( K + I * 4 ) ) );
+    cdgh = _mm_sha256rnds2_epu32( cdgh, abef, tmp );
+
+    if constexpr ( I >= 3 && I <= 14 )
+    {
+        const __m128i w = _mm_alignr_epi8( msg[I % 4], msg[(I + 3) % 4], 4 );
+        msg[(I + 1) % 4] = _mm_sha256msg2_epu32( _mm_add_epi32( msg[(I + 1) % 4], w ), msg[I % 4] );
+    }
+
+    tmp = _mm_shuffle_epi32( tmp, 0x0E );
+    abef = _mm_sha256rnds2_epu32( abef, cdgh, tmp );
+
+    if constexpr ( I >= 1 && I <= 12 )
+        msg[(I + 3) % 4] = _mm_sha256msg1_epu32( msg[(I + 3) % 4], msg[I % 4] );
+}
+
+template <int... I>
+SHANI_TARGET static inline void sha256_shani_steps( __m128i& abef, __m128i& cdgh, __m128i msg[4], std::integer_sequence<int, I...> )
+{
+    ( sha256_shani_step<I>( abef, cdgh, msg ), ... );
+}
+
+SHANI_TARGET static void sha256_process_shani( uint32_t state[8], const unsigned char *data, size_t blocks )
+{
+    const __m128i mask = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+
+    const __m128i dcba = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( state ) ), 0xB1 );
+    const __m128i efgh = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( state + 4 ) ), 0x1B );
+
+    __m128i abef = _mm_alignr_epi8( dcba, efgh, 8 );
+    __m128i cdgh = _mm_blend_epi16( efgh, dcba, 0xF0 );
+
+    for( ; blocks; blocks--, data += 64 )
+    {
+        const __m128i abef_save = abef;
+        const __m128i cdgh_save = cdgh;
+
+        __m128i msg[4];
+
+        for( int i = 0; i < 4; i++ )
+            msg[i] = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + i * 16 ) ), mask );
+
+        sha256_shani_steps( abef, cdgh, msg, std::make_integer_sequence<int, 16>{} );
+
+        abef = _mm_add_epi32( abef, abef_save );
+        cdgh = _mm_add_epi32( cdgh, cdgh_save );
+    }
+
+    const __m128i feba = _mm_shuffle_epi32( abef, 0x1B );
+    const __m128i dchg = _mm_shuffle_epi32( cdgh, 0xB1 );
+
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( state ), _mm_blend_epi16( feba, dchg, 0xF0 ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( state + 4 ), _mm_alignr_epi8( dchg, feba, 8 ) );
+}
+#endif
+
+/*
+ * Process a number of consecutive 64-byte blocks
+ */
+static int sha256_process_blocks( mbedtls_sha256_context *ctx, const unsigned char *data, size_t blocks )
+{
+#if defined(ARCH_X64) && !defined(MBEDTLS_SHA256_PROCESS_ALT)
+    if( utils::has_sha() )
+    {
+        sha256_process_shani( ctx->state, data, blocks );
+        return( 0 );
+    }
+#endif
+
+    int ret;
+
+    for( ; blocks; blocks--, data += 64 )
+    {
+        if( ( ret = mbedtls_internal_sha256_process( ctx, data ) ) != 0 )
+            return( ret );
+    }
+
+    return( 0 );
+}
+
 /*
  * SHA-256 process buffer
  */
@@ -291,7 +389,7 @@ int mbedtls_sha256_update_ret( mbedtls_sha256_context *ctx,
     {
         memcpy( ctx->buffer + left, input, fill );
 
-        if( ( ret = mbedtls_internal_sha256_process( ctx, ctx->buffer ) ) != 0 )
+        if( ( ret = sha256_process_blocks( ctx, ctx->buffer, 1 ) ) != 0 )
             return( ret );
 
         input += fill;
@@ -299,13 +397,13 @@ int mbedtls_sha256_update_ret( mbedtls_sha256_context *ctx,
         left = 0;
     }
 
-    while( ilen >= 64 )
+    if( ilen >= 64 )
     {
-        if( ( ret = mbedtls_internal_sha256_process( ctx, input ) ) != 0 )
+        if( ( ret = sha256_process_blocks( ctx, input, ilen / 64 ) ) != 0 )
             return( ret );
 
-        input += 64;
-        ilen  -= 64;
+        input += ilen & ~size_t{63};
+        ilen  &= 63;
     }
 
     if( ilen > 0 )
@@ -353,7 +451,7 @@ int mbedtls_sha256_finish_ret( mbedtls_sha256_context *ctx,
         /* We'll need an extra block */
         memset( ctx->buffer + used, 0, 64 - used );
 
-        if( ( ret = mbedtls_internal_sha256_process( ctx, ctx->buffer ) ) != 0 )
+        if( ( ret = sha256_process_blocks( ctx, ctx->buffer, 1 ) ) != 0 )
             return( ret );
 
         memset( ctx->buffer, 0, 56 );
@@ -369,7 +467,7 @@ int mbedtls_sha256_finish_ret( mbedtls_sha256_context *ctx,
     PUT_UINT32_BE( high, ctx->buffer, 56 );
     PUT_UINT32_BE( low,  ctx->buffer, 60 );
 
-    if( ( ret = mbedtls_internal_sha256_process( ctx, ctx->buffer ) ) != 0 )
+    if( ( ret = sha256_process_blocks( ctx, ctx->buffer, 1 ) ) != 0 )
         return( ret );
 
     /*
@@ -5,7 +5,9 @@
 #include "Emu/VFS.h"
 #include "Emu/System.h"
 #include "Emu/system_utils.hpp"
+#include "Emu/system_config.h"
 #include "Crypto/unzip.h"
+#include "Crypto/sha1.h"
 
 #include <algorithm>
 
@@ -725,30 +727,23 @@ bool SCEDecrypter::DecryptData()
 				memcpy(data_key, data_keys.get() + meta_shdr[i].key_idx * 0x10, 0x10);
 				memcpy(data_iv, data_keys.get() + meta_shdr[i].iv_idx * 0x10, 0x10);
 
-				// Allocate a buffer to hold the data.
-				auto buf = std::make_unique<u8[]>(meta_shdr[i].data_size);
-
-				// Seek to the section data offset and read the encrypted data.
+				// Seek to the section data offset and read the encrypted data directly into the output buffer.
+				u8* const buf = data_buf.get() + data_buf_offset;
 				sce_f.seek(meta_shdr[i].data_offset);
-				sce_f.read(buf.get(), meta_shdr[i].data_size);
+				sce_f.read(buf, meta_shdr[i].data_size);
 
 				// Zero out our ctr nonce.
 				memset(ctr_stream_block, 0, sizeof(ctr_stream_block));
 
-				// Perform AES-CTR encryption on the data blocks.
+				// Perform AES-CTR decryption in place.
 				aes_setkey_enc(&aes, data_key, 128);
-				aes_crypt_ctr(&aes, meta_shdr[i].data_size, &ctr_nc_off, data_iv, ctr_stream_block, buf.get(), buf.get());
-
-				// Copy the decrypted data.
-				memcpy(data_buf.get() + data_buf_offset, buf.get(), meta_shdr[i].data_size);
+				aes_crypt_ctr(&aes, meta_shdr[i].data_size, &ctr_nc_off, data_iv, ctr_stream_block, buf, buf);
 			}
 		}
 		else
 		{
-			auto buf = std::make_unique<u8[]>(meta_shdr[i].data_size);
 			sce_f.seek(meta_shdr[i].data_offset);
-			sce_f.read(buf.get(), meta_shdr[i].data_size);
-			memcpy(data_buf.get() + data_buf_offset, buf.get(), meta_shdr[i].data_size);
+			sce_f.read(data_buf.get() + data_buf_offset, meta_shdr[i].data_size);
 		}
 
 		// Advance the buffer's offset.
@@ -1203,22 +1198,17 @@ bool SELFDecrypter::DecryptData()
 				memcpy(data_key, data_keys.get() + meta_shdr[i].key_idx * 0x10, 0x10);
 				memcpy(data_iv, data_keys.get() + meta_shdr[i].iv_idx * 0x10, 0x10);
 
-				// Allocate a buffer to hold the data.
-				auto buf = std::make_unique<u8[]>(meta_shdr[i].data_size);
-
-				// Seek to the section data offset and read the encrypted data.
+				// Seek to the section data offset and read the encrypted data directly into the output buffer.
+				u8* const buf = data_buf.get() + data_buf_offset;
 				self_f.seek(meta_shdr[i].data_offset);
-				self_f.read(buf.get(), meta_shdr[i].data_size);
+				self_f.read(buf, meta_shdr[i].data_size);
 
 				// Zero out our ctr nonce.
 				memset(ctr_stream_block, 0, sizeof(ctr_stream_block));
 
-				// Perform AES-CTR encryption on the data blocks.
+				// Perform AES-CTR decryption in place.
 				aes_setkey_enc(&aes, data_key, 128);
-				aes_crypt_ctr(&aes, meta_shdr[i].data_size, &ctr_nc_off, data_iv, ctr_stream_block, buf.get(), buf.get());
-
-				// Copy the decrypted data.
-				memcpy(data_buf.get() + data_buf_offset, buf.get(), meta_shdr[i].data_size);
+				aes_crypt_ctr(&aes, meta_shdr[i].data_size, &ctr_nc_off, data_iv, ctr_stream_block, buf, buf);
 
 				// Advance the buffer's offset.
 				data_buf_offset += ::narrow<u32>(meta_shdr[i].data_size);
@@ -1363,6 +1353,91 @@ static bool CheckDebugSelf(fs::file& s)
 	return false;
 }
 
+namespace self_cache
+{
+	// Bump when the decrypted output format changes
+	static constexpr u32 cache_version = 1;
+
+	// The SCE header block contains the encrypted metadata keys and section hashes, which identify the file
+	static std::string get_path(const fs::file& self, const u8* klic_key)
+	{
+		if (!g_cfg.core.self_cache)
+		{
+			return {};
+		}
+
+		SceHeader sce_hdr{};
+		self.seek(0);
+		sce_hdr.Load(self);
+
+		const u64 file_size = self.size();
+
+		if (!sce_hdr.CheckMagic() || !sce_hdr.se_hsize || sce_hdr.se_hsize > std::min<u64>(file_size, 0x100000))
+		{
+			return {};
+		}
+
+		std::vector<u8> header(sce_hdr.se_hsize);
+
+		if (self.read_at(0, header.data(), header.size()) != header.size())
+		{
+			return {};
+		}
+
+		sha1_context ctx;
+		sha1_starts(&ctx);
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&cache_version), sizeof(cache_version));
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&file_size), sizeof(file_size));
+		sha1_update(&ctx, header.data(), header.size());
+
+		if (klic_key)
+		{
+			sha1_update(&ctx, klic_key, 0x10);
+		}
+
+		u8 key[20]{};
+		sha1_finish(&ctx, key);
+
+		return rpcs3::utils::get_cache_dir() + "self/" + fmt::format("%s.elf", fmt::base57(key));
+	}
+
+	static fs::file load(const std::string& path)
+	{
+		if (path.empty())
+		{
+			return {};
+		}
+
+		fs::file cached(path);
+
+		if (!cached || cached.size() < 4 || cached.read<u32>() != "\177ELF"_u32)
+		{
+			return {};
+		}
+
+		cached.seek(0);
+		self_log.trace("Loaded decrypted executable from cache: %s", path);
+		return cached;
+	}
+
+	static void save(const std::string& path, const fs::file& elf)
+	{
+		if (path.empty() || !fs::create_path(fs::get_parent_dir(path)))
+		{
+			return;
+		}
+
+		const std::vector<u8> data = elf.to_vector<u8>();
+
+		fs::pending_file file(path);
+
+		if (!file.file || file.file.write(data.data(), data.size()) != data.size() || !file.commit())
+		{
+			self_log.warning("Failed to write decrypted executable cache %s (%s)", path, fs::g_tls_error);
+		}
+	}
+}
+
 fs::file decrypt_self(fs::file elf_or_self, u8* klic_key, SelfAdditionalInfo* out_info, bool require_encrypted)
 {
 	if (out_info)
@@ -1386,6 +1461,14 @@ fs::file decrypt_self(fs::file elf_or_self, u8* klic_key, SelfAdditionalInfo* ou
 			return elf_or_self;
 		}
 
+		// Additional info is only available from the SELF headers
+		const std::string cache_path = out_info ? std::string{} : self_cache::get_path(elf_or_self, klic_key);
+
+		if (fs::file cached = self_cache::load(cache_path))
+		{
+			return cached;
+		}
+
 		// Check the ELF file class (32 or 64 bit).
 		const bool isElf32 = IsSelfElf32(elf_or_self);
 
@@ -1414,7 +1497,10 @@ fs::file decrypt_self(fs::file elf_or_self, u8* klic_key, SelfAdditionalInfo* ou
 		}
 
 		// Make a new ELF file from this SELF.
-		return self_dec.MakeElf(isElf32);
+		fs::file elf = self_dec.MakeElf(isElf32);
+
+		self_cache::save(cache_path, elf);
+		return elf;
 	}
 
 	if (require_encrypted)
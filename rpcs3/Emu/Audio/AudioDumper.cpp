@@ -3,9 +3,126 @@
 
 #include "Utilities/date_time.h"
 #include "Emu/System.h"
+#include "Emu/Cell/timers.hpp"
 
 #include <bit>
 
+void audio_dump_writer::write(const void* buffer, u32 size, u32 sample_size)
+{
+	const u8* src = static_cast<const u8*>(buffer);
+
+	// Convert the samples of one contiguous ring segment
+	const auto copy = [sample_size](u8* dst, const u8* src, u32 count)
+	{
+		if constexpr (std::endian::big == std::endian::native)
+		{
+			if (sample_size == sizeof(f32))
+			{
+				for (u32 i = 0; i < count; i += sizeof(f32))
+				{
+					write_to_ptr(dst + i, le_t<u32>{read_from_ptr<u32>(src + i)});
+				}
+			}
+			else
+			{
+				for (u32 i = 0; i < count; i += sizeof(s16))
+				{
+					write_to_ptr(dst + i, le_t<u16>{read_from_ptr<u16>(src + i)});
+				}
+			}
+		}
+		else
+		{
+			std::memcpy(dst, src, count);
+		}
+	};
+
+	const u32 wpos = write_pos;
+
+	for (u32 done = 0; done < size;)
+	{
+		// Positions are multiples of the sample size, and so is the free space
+		const u32 rpos = read_pos;
+		const u32 avail = ring_size - (wpos + done - rpos);
+
+		if (!avail)
+		{
+			read_pos.wait(rpos);
+			continue;
+		}
+
+		const u32 count = std::min(avail, size - done);
+		const u32 offset = (wpos + done) % ring_size;
+		const u32 first = std::min(count, ring_size - offset);
+
+		copy(ring.get() + offset, src + done, first);
+		copy(ring.get(), src + done + first, count - first);
+
+		done += count;
+		write_pos.release(wpos + done);
+		write_pos.notify_one();
+	}
+}
+
+void audio_dump_writer::operator()()
+{
+	// Rewrite the header periodically, so that the file stays valid if the emulator does not shut down cleanly
+	constexpr u64 header_update_period = 1'000'000;
+
+	u64 last_header_update = get_system_time();
+
+	while (true)
+	{
+		const bool aborting = thread_ctrl::state() == thread_state::aborting;
+
+		const u32 wpos = write_pos;
+
+		if (const u32 rpos = read_pos; wpos != rpos)
+		{
+			const u32 size = wpos - rpos;
+			const u32 offset = rpos % ring_size;
+			const u32 first = std::min(size, ring_size - offset);
+
+			ensure(output.write(ring.get() + offset, first) == first);
+			ensure(output.write(ring.get(), size - first) == size - first);
+
+			header.Size += size;
+			header.RIFF.Size += size;
+			header.FACT.SampleLength += size / header.FMT.BlockAlign;
+
+			read_pos.release(wpos);
+			read_pos.notify_one();
+		}
+
+		if (aborting)
+		{
+			break;
+		}
+
+		if (const u64 now = get_system_time(); now - last_header_update >= header_update_period)
+		{
+			const u64 pos = output.pos();
+			output.seek(0);
+			output.write(header);
+			output.seek(pos);
+			last_header_update = now;
+		}
+
+		thread_ctrl::wait_on(write_pos, wpos);
+	}
+
+	if (header.Size & 1)
+	{
+		const u8 pad_byte = 0;
+		output.write(pad_byte);
+		header.RIFF.Size += 1;
+	}
+
+	output.seek(0);
+	output.write(header); // write file header
+	output.close();
+}
+
 AudioDumper::AudioDumper()
 {
 }
@@ -26,24 +143,18 @@ void AudioDumper::Open(AudioChannelCnt ch, AudioFreq sample_rate, AudioSampleSiz
 		path += id + "_";
 	}
 	path += date_time::current_time_narrow<'_'>() + ".wav";
-	m_output.open(path, fs::rewrite);
-	m_output.seek(sizeof(m_header));
+
+	fs::file output(path, fs::rewrite);
+	output.seek(sizeof(m_header));
+	m_writer = std::make_unique<named_thread<audio_dump_writer>>(std::move(output), m_header);
 }
 
 void AudioDumper::Close()
 {
 	if (GetCh())
 	{
-		if (m_header.Size & 1)
-		{
-			const u8 pad_byte = 0;
-			m_output.write(pad_byte);
-			m_header.RIFF.Size += 1;
-		}
-
-		m_output.seek(0);
-		m_output.write(m_header); // write file header
-		m_output.close();
+		// Flushes the remaining data and finalizes the header
+		m_writer.reset();
 		m_header.FMT.NumChannels = 0;
 	}
 }
@@ -57,34 +168,6 @@ void AudioDumper::WriteData(const void* buffer, u32 size)
 
 		ensure(size - sample_cnt_per_ch * blk_size == 0);
 
-		if constexpr (std::endian::big == std::endian::native)
-		{
-			std::vector<u8> tmp_buf(size);
-
-			if (GetSampleSize() == sizeof(f32))
-			{
-				for (u32 sample_idx = 0; sample_idx < sample_cnt_per_ch * GetCh(); sample_idx++)
-				{
-					std::bit_cast<f32*>(tmp_buf.data())[sample_idx] = static_cast<const be_t<f32>*>(buffer)[sample_idx];
-				}
-			}
-			else
-			{
-				for (u32 sample_idx = 0; sample_idx < sample_cnt_per_ch * GetCh(); sample_idx++)
-				{
-					std::bit_cast<s16*>(tmp_buf.data())[sample_idx] = static_cast<const be_t<s16>*>(buffer)[sample_idx];
-				}
-			}
-
-			ensure(m_output.write(tmp_buf.data(), size) == size);
-		}
-		else
-		{
-			ensure(m_output.write(buffer, size) == size);
-		}
-
-		m_header.Size += size;
-		m_header.RIFF.Size += size;
-		m_header.FACT.SampleLength += sample_cnt_per_ch;
+		m_writer->write(buffer, size, GetSampleSize());
 	}
 }
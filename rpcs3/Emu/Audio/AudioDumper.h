@@ -2,6 +2,7 @@
 
 #include "util/types.hpp"
 #include "Utilities/File.h"
+#include "Utilities/Thread.h"
 #include "Emu/Audio/AudioBackend.h"
 
 struct WAVHeader
@@ -72,10 +73,38 @@ struct WAVHeader
 	}
 };
 
+// Writes the audio data on its own thread, so that the audio thread never waits for the disk
+struct audio_dump_writer
+{
+	static constexpr auto thread_name = "Audio Dumper"sv;
+
+	// Single producer, single consumer byte ring (power of 2)
+	static constexpr u32 ring_size = 4 * 1024 * 1024;
+
+	fs::file output;
+	WAVHeader header;
+
+	const std::unique_ptr<u8[]> ring;
+	atomic_t<u32> write_pos = 0; // Advanced by the audio thread (wraps around at a multiple of ring_size)
+	atomic_t<u32> read_pos = 0; // Advanced by the writer thread
+
+	audio_dump_writer(fs::file&& file, const WAVHeader& hdr)
+		: output(std::move(file))
+		, header(hdr)
+		, ring(new u8[ring_size])
+	{
+	}
+
+	// Copy samples to the ring in little endian (waits only if the ring is full)
+	void write(const void* buffer, u32 size, u32 sample_size);
+
+	void operator()();
+};
+
 class AudioDumper
 {
 	WAVHeader m_header{};
-	fs::file m_output{};
+	std::unique_ptr<named_thread<audio_dump_writer>> m_writer;
 
 public:
 	AudioDumper();
@@ -1,6 +1,133 @@
 #include "stdafx.h"
 #include "Emu/Audio/audio_resampler.h"
+#include "Emu/system_config.h"
+#include "Emu/perf_meter.hpp"
 #include <algorithm>
+#include <cmath>
+#include <numbers>
+
+polyphase_resampler::polyphase_resampler()
+{
+	// Blackman windowed sinc, the cutoff is at the input Nyquist frequency since the ratio never exceeds 1
+	constexpr f64 half = taps / 2;
+	constexpr f64 pi = std::numbers::pi;
+
+	m_filter.resize((phases + 1) * taps);
+
+	for (u32 p = 0; p <= phases; p++)
+	{
+		f32* row = &m_filter[p * taps];
+		f64 sum = 0;
+
+		for (u32 k = 0; k < taps; k++)
+		{
+			const f64 x = k - (half - 1) - static_cast<f64>(p) / phases;
+			const f64 sinc = x == 0 ? 1.0 : std::sin(pi * x) / (pi * x);
+			const f64 window = 0.42 + 0.5 * std::cos(pi * x / half) + 0.08 * std::cos(2 * pi * x / half);
+			row[k] = static_cast<f32>(sinc * window);
+			sum += row[k];
+		}
+
+		for (u32 k = 0; k < taps; k++)
+		{
+			row[k] = static_cast<f32>(row[k] / sum);
+		}
+	}
+
+	clear();
+}
+
+void polyphase_resampler::set_channels(u32 ch_cnt)
+{
+	m_channels = ch_cnt;
+	clear();
+}
+
+void polyphase_resampler::clear()
+{
+	// Prime the history so that the first input frame lands on the center tap
+	m_input.assign((taps / 2 - 1) * m_channels, 0.0f);
+	m_output.clear();
+	m_out_pos = 0;
+	m_pos = 0;
+}
+
+void polyphase_resampler::put_samples(const f32* buf, u32 sample_cnt)
+{
+	const u32 ch = m_channels;
+
+	// Drop the output returned by get_samples
+	m_output.erase(m_output.begin(), m_output.begin() + m_out_pos * ch);
+	m_out_pos = 0;
+
+	m_input.insert(m_input.end(), buf, buf + sample_cnt * ch);
+
+	const u32 in_frames = static_cast<u32>(m_input.size() / ch);
+
+	if (in_frames < taps)
+	{
+		return;
+	}
+
+	// Every output frame needs taps input frames starting at floor(m_pos)
+	const u32 out_frames = static_cast<u32>(std::max(std::floor((in_frames - taps + 1 - m_pos) / m_ratio), 0.0));
+
+	usz out_index = m_output.size();
+	m_output.resize(out_index + usz{out_frames} * ch);
+
+	f32 coef[taps];
+
+	for (u32 i = 0; i < out_frames; i++, out_index += ch)
+	{
+		const u32 ipos = static_cast<u32>(m_pos);
+		const f64 phase = (m_pos - ipos) * phases;
+		const u32 p = static_cast<u32>(phase);
+		const f32 t = static_cast<f32>(phase - p);
+
+		if (ipos + taps > in_frames)
+		{
+			// Rounding guard
+			m_output.resize(out_index);
+			break;
+		}
+
+		const f32* f0 = &m_filter[p * taps];
+		const f32* f1 = f0 + taps;
+
+		for (u32 k = 0; k < taps; k++)
+		{
+			coef[k] = f0[k] + (f1[k] - f0[k]) * t;
+		}
+
+		const f32* in = &m_input[usz{ipos} * ch];
+		f32* out = &m_output[out_index];
+
+		std::fill_n(out, ch, 0.0f);
+
+		for (u32 k = 0; k < taps; k++, in += ch)
+		{
+			for (u32 c = 0; c < ch; c++)
+			{
+				out[c] += in[c] * coef[k];
+			}
+		}
+
+		m_pos += m_ratio;
+	}
+
+	// Discard fully consumed input frames
+	const u32 consumed = std::min(static_cast<u32>(m_pos), in_frames);
+	m_input.erase(m_input.begin(), m_input.begin() + usz{consumed} * ch);
+	m_pos -= consumed;
+}
+
+std::pair<f32*, u32> polyphase_resampler::get_samples(u32 sample_cnt)
+{
+	const u32 count = std::min(sample_cnt, samples_available());
+	f32* const buf = m_output.data() + usz{m_out_pos} * m_channels;
+	m_out_pos += count;
+	return std::make_pair(buf, count);
+}
 
 audio_resampler::audio_resampler()
 {
@@ -15,24 +142,40 @@ audio_resampler::~audio_resampler()
 void audio_resampler::set_params(AudioChannelCnt ch_cnt, AudioFreq freq)
 {
 	flush();
+	use_polyphase = g_cfg.audio.resampler == time_stretching_engine::polyphase;
 	resampler.setChannels(static_cast<u32>(ch_cnt));
 	resampler.setSampleRate(static_cast<u32>(freq));
+	polyphase.set_channels(static_cast<u32>(ch_cnt));
 }
 
 f64 audio_resampler::set_tempo(f64 new_tempo)
 {
 	new_tempo = std::clamp(new_tempo, RESAMPLER_MIN_FREQ_VAL, RESAMPLER_MAX_FREQ_VAL);
 	resampler.setTempo(new_tempo);
+	polyphase.set_ratio(new_tempo);
 	return new_tempo;
 }
 
 void audio_resampler::put_samples(const f32* buf, u32 sample_cnt)
 {
+	perf_meter<"AUDIO_RS"_u64> perf0;
+
+	if (use_polyphase)
+	{
+		polyphase.put_samples(buf, sample_cnt);
+		return;
+	}
+
 	resampler.putSamples(buf, sample_cnt);
 }
 
 std::pair<f32* /* buffer */, u32 /* samples */> audio_resampler::get_samples(u32 sample_cnt)
 {
+	if (use_polyphase)
+	{
+		return polyphase.get_samples(sample_cnt);
+	}
+
 	// NOTE: Make sure to get the buffer first because receiveSamples advances its position internally
 	//       and std::make_pair evaluates the second parameter first...
 	f32 *const buf = resampler.bufBegin();
@@ -41,15 +184,26 @@ std::pair<f32* /* buffer */, u32 /* samples */> audio_resampler::get_samples(u32
 
 u32 audio_resampler::samples_available() const
 {
+	if (use_polyphase)
+	{
+		return polyphase.samples_available();
+	}
+
 	return resampler.numSamples();
 }
 
 f64 audio_resampler::get_resample_ratio()
 {
+	if (use_polyphase)
+	{
+		return polyphase.get_ratio();
+	}
+
 	return resampler.getInputOutputSampleRatio();
 }
 
 void audio_resampler::flush()
 {
 	resampler.clear();
+	polyphase.clear();
 }
@@ -13,9 +13,41 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <vector>
+
 constexpr f64 RESAMPLER_MAX_FREQ_VAL = 1.0;
 constexpr f64 RESAMPLER_MIN_FREQ_VAL = 0.1;
 
+// Windowed-sinc rate converter with a fixed latency of half its taps
+class polyphase_resampler
+{
+public:
+	static constexpr u32 taps = 16;
+	static constexpr u32 phases = 256;
+
+	polyphase_resampler();
+
+	void set_channels(u32 ch_cnt);
+	void set_ratio(f64 ratio) { m_ratio = ratio; }
+	f64 get_ratio() const { return m_ratio; }
+
+	void put_samples(const f32* buf, u32 sample_cnt);
+	std::pair<f32*, u32> get_samples(u32 sample_cnt);
+
+	u32 samples_available() const { return static_cast<u32>(m_output.size() / m_channels) - m_out_pos; }
+
+	void clear();
+
+private:
+	std::vector<f32> m_filter; // (phases + 1) rows of taps coefficients
+	std::vector<f32> m_input;  // Interleaved input frames not yet fully consumed
+	std::vector<f32> m_output; // Interleaved output frames
+	u32 m_out_pos = 0;         // Output frames already returned
+	u32 m_channels = 2;
+	f64 m_pos = 0;             // Fractional read position in m_input frames
+	f64 m_ratio = 1.0;         // Input frames consumed per output frame
+};
+
 class audio_resampler
 {
 public:
@@ -34,5 +66,7 @@ public:
 	void flush();
 
 private:
+	bool use_polyphase = false;
 	soundtouch::SoundTouch resampler{};
+	polyphase_resampler polyphase{};
 };
@@ -634,7 +634,7 @@ void cpu_thread::operator()()
 
 	g_tls_this_thread = this;
 
-	if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+	if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os && g_cfg.core.thread_scheduler != thread_scheduler_mode::os_lv2_queues)
 	{
 		thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(get_class()));
 	}
@@ -7,6 +7,8 @@
 #include "Emu/Cell/Modules/cellAudioOut.h"
 #include "cellAudio.h"
 #include "util/video_provider.h"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 #include <cmath>
 
@@ -1054,34 +1056,55 @@ void cell_audio_thread::mix(float* out_buffer, s32 offset)
 		auto buf = port.get_vm_ptr(offset);
 
 		static constexpr float minus_3db = 0.707f; // value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
-		float m = master_volume;
 
 		// part of cellAudioSetPortLevel functionality
 		// spread port volume changes over 13ms
-		auto step_volume = [master_volume, &m](audio_port& port)
+		// The gain of every sample of the period is computed upfront, so the mixing loops below stay free of atomics and branches
+		alignas(64) std::array<float, AUDIO_BUFFER_SAMPLES> gain;
 		{
 			const audio_port::level_set_t param = port.level_set.load();
 
+			u32 i = 0;
+
 			if (param.inc != 0.0f)
 			{
-				port.level += param.inc;
 				const bool dec = param.inc < 0.0f;
 
-				if ((!dec && param.value - port.level <= 0.0f) || (dec && param.value - port.level >= 0.0f))
+				for (; i < AUDIO_BUFFER_SAMPLES; i++)
 				{
-					port.level = param.value;
-					port.level_set.compare_and_swap(param, { param.value, 0.0f });
+					port.level += param.inc;
+
+					if ((!dec && param.value - port.level <= 0.0f) || (dec && param.value - port.level >= 0.0f))
+					{
+						port.level = param.value;
+						port.level_set.compare_and_swap(param, { param.value, 0.0f });
+						break;
+					}
+
+					gain[i] = port.level * master_volume;
 				}
 			}
 
-			m = port.level * master_volume;
-		};
+			std::fill(gain.begin() + i, gain.end(), port.level * master_volume);
+		}
 
-		if (port.num_channels == 2)
+		if (port.num_channels == 2 && out_channels == 2)
+		{
+			// Four stereo frames per iteration
+			for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i += 4)
+			{
+				const v128 g = v128::loadu(gain.data() + i);
+				const v128 src0 = gv_to_be32(v128::loadu(buf + i * 2, 0));
+				const v128 src1 = gv_to_be32(v128::loadu(buf + i * 2, 1));
+				v128::storeu(gv_addfs(v128::loadu(out_buffer + i * 2, 0), gv_mulfs(src0, gv_unpacklo32(g, g))), out_buffer + i * 2, 0);
+				v128::storeu(gv_addfs(v128::loadu(out_buffer + i * 2, 1), gv_mulfs(src1, gv_unpackhi32(g, g))), out_buffer + i * 2, 1);
+			}
+		}
+		else if (port.num_channels == 2)
 		{
-			for (u32 out = 0, in = 0; out < out_buffer_sz; out += out_channels, in += 2)
+			for (u32 out = 0, in = 0, i = 0; out < out_buffer_sz; out += out_channels, in += 2, i++)
 			{
-				step_volume(port);
+				const float m = gain[i];
 
 				const float left  = buf[in + 0] * m;
 				const float right = buf[in + 1] * m;
@@ -1092,9 +1115,9 @@ void cell_audio_thread::mix(float* out_buffer, s32 offset)
 		}
 		else if (port.num_channels == 8)
 		{
-			for (u32 out = 0, in = 0; out < out_buffer_sz; out += out_channels, in += 8)
+			for (u32 out = 0, in = 0, i = 0; out < out_buffer_sz; out += out_channels, in += 8, i++)
 			{
-				step_volume(port);
+				const float m = gain[i];
 
 				const float left       = buf[in + 0] * m;
 				const float right      = buf[in + 1] * m;
@@ -1,11 +1,15 @@
 #include "stdafx.h"
 #include "Emu/VFS.h"
+#include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
 
 #include <stb_truetype.h>
 
 #include "cellFont.h"
 
+#include <list>
+#include <unordered_map>
+
 LOG_CHANNEL(cellFont);
 
 template <>
@@ -46,6 +50,140 @@ void fmt_class_string<CellFontError>::format(std::string& out, u64 arg)
 	});
 }
 
+// Cache of rasterized glyphs and their metrics, keyed by font data, pixel height and code point
+struct font_glyph_cache
+{
+	static constexpr usz memory_budget = 8 * 1024 * 1024;
+
+	struct key_t
+	{
+		u32 font_addr;
+		u32 scale_bits;
+		u32 code;
+
+		bool operator==(const key_t&) const = default;
+	};
+
+	struct key_hash
+	{
+		usz operator()(const key_t& key) const noexcept
+		{
+			return std::hash<u64>()((u64{key.font_addr} << 32 | key.code) ^ (u64{key.scale_bits} * 0x9e3779b97f4a7c15));
+		}
+	};
+
+	struct glyph
+	{
+		f32 scale;
+		s32 ascent, descent, line_gap;
+		s32 x0, y0, x1, y1;
+		s32 advance_width, left_side_bearing;
+
+		bool rasterized = false;
+		s32 width = 0, height = 0, xoff = 0, yoff = 0;
+		std::vector<u8> bitmap;
+
+		std::list<key_t>::iterator lru;
+
+		// Bytes charged to the cache budget (map and LRU nodes included)
+		usz charge() const
+		{
+			return entry_overhead + bitmap.size();
+		}
+	};
+
+	static constexpr usz entry_overhead = sizeof(key_t) + sizeof(glyph) + 4 * sizeof(void*);
+
+	shared_mutex mutex;
+	std::unordered_map<key_t, glyph, key_hash> glyphs;
+	std::list<key_t> lru; // Most recently used first
+	usz memory_used = 0;
+
+	atomic_t<u64> hits = 0;
+	atomic_t<u64> misses = 0;
+
+	// Get the glyph (rasterized on request), the result is valid until the next call
+	const glyph* get(stbtt_fontinfo* info, u32 font_addr, f32 pixel_height, u32 code, bool raster)
+	{
+		const key_t key{font_addr, std::bit_cast<u32>(pixel_height), code};
+
+		auto [it, inserted] = glyphs.try_emplace(key);
+		glyph& g = it->second;
+
+		if (inserted)
+		{
+			g.scale = stbtt_ScaleForPixelHeight(info, pixel_height);
+			stbtt_GetFontVMetrics(info, &g.ascent, &g.descent, &g.line_gap);
+			stbtt_GetCodepointBox(info, code, &g.x0, &g.y0, &g.x1, &g.y1);
+			stbtt_GetCodepointHMetrics(info, code, &g.advance_width, &g.left_side_bearing);
+			lru.push_front(key);
+			g.lru = lru.begin();
+			memory_used += entry_overhead;
+		}
+		else
+		{
+			lru.splice(lru.begin(), lru, g.lru);
+		}
+
+		if (raster && !g.rasterized)
+		{
+			misses++;
+
+			if (u8* box = stbtt_GetCodepointBitmap(info, g.scale, g.scale, code, &g.width, &g.height, &g.xoff, &g.yoff))
+			{
+				g.bitmap.assign(box, box + usz{static_cast<u32>(g.width)} * static_cast<u32>(g.height));
+				stbtt_FreeBitmap(box, nullptr);
+			}
+
+			g.rasterized = true;
+			memory_used += g.bitmap.size();
+		}
+		else if (raster)
+		{
+			hits++;
+		}
+
+		// Evict least recently used glyphs (never the current one, which is at the front)
+		while (memory_used > memory_budget && lru.size() > 1)
+		{
+			const auto old = glyphs.find(lru.back());
+			memory_used -= old->second.charge();
+			glyphs.erase(old);
+			lru.pop_back();
+		}
+
+		return &g;
+	}
+
+	// Drop all glyphs of a closed font
+	void invalidate(u32 font_addr)
+	{
+		std::lock_guard lock(mutex);
+
+		for (auto it = glyphs.begin(); it != glyphs.end();)
+		{
+			if (it->first.font_addr == font_addr)
+			{
+				memory_used -= it->second.charge();
+				lru.erase(it->second.lru);
+				it = glyphs.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+	}
+
+	~font_glyph_cache()
+	{
+		if (const u64 total = hits + misses)
+		{
+			cellFont.notice("Glyph cache: %u hits, %u misses (%.1f%% hit rate), %u bytes used", hits.load(), misses.load(), hits.load() * 100.0 / total, memory_used);
+		}
+	}
+};
+
 // Functions
 error_code cellFontInitializeWithRevision(u64 revisionFlags, vm::ptr<CellFontConfig> config)
 {
@@ -324,6 +462,7 @@ error_code cellFontOpenFontInstance(vm::ptr<CellFont> openedFont, vm::ptr<CellFo
 	font->scale_y = openedFont->scale_y;
 	font->slant = openedFont->slant;
 	font->stbfont = openedFont->stbfont;
+	font->fontdata_addr = openedFont->fontdata_addr; // Shares the glyph cache entries of the opened font
 	font->origin = CELL_FONT_OPEN_FONT_INSTANCE;
 
 	return CELL_OK;
@@ -549,13 +688,14 @@ error_code cellFontGetHorizontalLayout(vm::ptr<CellFont> font, vm::ptr<CellFontH
 		return CELL_FONT_ERROR_INVALID_PARAMETER;
 	}
 
-	s32 ascent, descent, lineGap;
-	const f32 scale = stbtt_ScaleForPixelHeight(font->stbfont, font->scale_y);
-	stbtt_GetFontVMetrics(font->stbfont, &ascent, &descent, &lineGap);
+	auto& cache = g_fxo->get<font_glyph_cache>();
+	std::lock_guard lock(cache.mutex);
+
+	const auto g = cache.get(font->stbfont, font->fontdata_addr, font->scale_y, 0, false);
 
-	layout->baseLineY = ascent * scale;
-	layout->lineHeight = (ascent-descent+lineGap) * scale;
-	layout->effectHeight = lineGap * scale;
+	layout->baseLineY = g->ascent * g->scale;
+	layout->lineHeight = (g->ascent - g->descent + g->line_gap) * g->scale;
+	layout->effectHeight = g->line_gap * g->scale;
 
 	return CELL_OK;
 }
@@ -707,20 +847,24 @@ error_code cellFontRenderCharGlyphImage(vm::ptr<CellFont> font, u32 code, vm::pt
 		return CELL_FONT_ERROR_RENDERER_UNBIND;
 	}
 
-	// Render the character
-	s32 width, height, xoff, yoff;
-	const f32 scale = stbtt_ScaleForPixelHeight(font->stbfont, font->scale_y);
-	unsigned char* box = stbtt_GetCodepointBitmap(font->stbfont, scale, scale, code, &width, &height, &xoff, &yoff);
+	auto& cache = g_fxo->get<font_glyph_cache>();
+	std::lock_guard lock(cache.mutex);
 
-	if (!box)
+	// Render the character (or reuse the cached bitmap)
+	const auto g = cache.get(font->stbfont, font->fontdata_addr, font->scale_y, code, true);
+
+	if (g->bitmap.empty())
 	{
 		return CELL_OK;
 	}
 
+	const s32 width = g->width;
+	const s32 height = g->height;
+	const s32 yoff = g->yoff;
+	const u8* box = g->bitmap.data();
+
 	// Get the baseLineY value
-	s32 ascent, descent, lineGap;
-	stbtt_GetFontVMetrics(font->stbfont, &ascent, &descent, &lineGap);
-	const s32 baseLineY = static_cast<int>(ascent * scale); // ???
+	const s32 baseLineY = static_cast<int>(g->ascent * g->scale); // ???
 
 	// Move the rendered character to the surface
 	unsigned char* buffer = vm::_ptr<unsigned char>(surface->buffer.addr());
@@ -738,7 +882,6 @@ error_code cellFontRenderCharGlyphImage(vm::ptr<CellFont> font, u32 code, vm::pt
 			buffer[(static_cast<s32>(y) + ypos + yoff + baseLineY) * surface->width + static_cast<s32>(x) + xpos] = box[ypos * width + xpos];
 		}
 	}
-	stbtt_FreeBitmap(box, nullptr);
 	return CELL_OK;
 }
 
@@ -862,6 +1005,12 @@ error_code cellFontCloseFont(vm::ptr<CellFont> font)
 		vm::dealloc(font->fontdata_addr, vm::main);
 	}
 
+	if (font->origin != CELL_FONT_OPEN_FONT_INSTANCE)
+	{
+		// Instances don't own the font data, which stays valid until the original font is closed
+		g_fxo->get<font_glyph_cache>().invalidate(font->fontdata_addr);
+	}
+
 	return CELL_OK;
 }
 
@@ -884,18 +1033,18 @@ error_code cellFontGetCharGlyphMetrics(vm::ptr<CellFont> font, u32 code, vm::ptr
 		return CELL_FONT_ERROR_NO_SUPPORT_CODE;
 	}
 
-	s32 x0, y0, x1, y1;
-	s32 advanceWidth, leftSideBearing;
-	const f32 scale = stbtt_ScaleForPixelHeight(font->stbfont, font->scale_y);
-	stbtt_GetCodepointBox(font->stbfont, code, &x0, &y0, &x1, &y1);
-	stbtt_GetCodepointHMetrics(font->stbfont, code, &advanceWidth, &leftSideBearing);
+	auto& cache = g_fxo->get<font_glyph_cache>();
+	std::lock_guard lock(cache.mutex);
+
+	const auto g = cache.get(font->stbfont, font->fontdata_addr, font->scale_y, code, false);
+	const f32 scale = g->scale;
 
 	// TODO: Add the rest of the information
-	metrics->width = (x1-x0) * scale;
-	metrics->height = (y1-y0) * scale;
-	metrics->h_bearingX = leftSideBearing * scale;
+	metrics->width = (g->x1 - g->x0) * scale;
+	metrics->height = (g->y1 - g->y0) * scale;
+	metrics->h_bearingX = g->left_side_bearing * scale;
 	metrics->h_bearingY = 0.f;
-	metrics->h_advance = advanceWidth * scale;
+	metrics->h_advance = g->advance_width * scale;
 	metrics->v_bearingX = 0.f;
 	metrics->v_bearingY = 0.f;
 	metrics->v_advance = 0.f;
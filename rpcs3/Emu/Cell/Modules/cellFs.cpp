@@ -3,9 +3,12 @@
 #include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
 
+#include "Emu/Cell/lv2/sys_event.h"
 #include "Emu/Cell/lv2/sys_fs.h"
+#include "Emu/Cell/lv2/sys_ppu_thread.h"
 #include "Emu/Cell/lv2/sys_sync.h"
 #include "cellFs.h"
+#include "sysPrxForUser.h"
 
 #include <mutex>
 
@@ -890,123 +893,192 @@ s32 cellFsStReadWaitCallback(u32 fd, u64 size, vm::ptr<void(s32 xfd, u64 xsize)>
 
 using fs_aio_cb_t = vm::ptr<void(vm::ptr<CellFsAio> xaio, s32 error, s32 xid, u64 size)>;
 
-struct fs_aio_thread : ppu_thread
+extern std::unique_lock<shared_mutex> lock_lv2_mutex_alike(shared_mutex& mtx, ppu_thread* ppu);
+
+struct fs_aio_manager
 {
-	using ppu_thread::ppu_thread;
+	shared_mutex mutex;
+	s32 init_ctr = 0;
+	u32 ppu_id = 0;
+	u32 queue_id = 0;
 
-	void non_task()
-	{
-		while (cmd64 cmd = cmd_wait())
-		{
-			const u32 type = cmd.arg1<u32>();
-			const s32 xid = cmd.arg2<s32>();
-			const cmd64 cmd2 = cmd_get(1);
-			const auto aio = cmd2.arg1<vm::ptr<CellFsAio>>();
-			const auto func = cmd2.arg2<fs_aio_cb_t>();
-			cmd_pop(1);
+	SAVESTATE_INIT_POS(54);
 
-			s32 error = CELL_EBADF;
-			u64 result = 0;
+	fs_aio_manager() = default;
 
-			const auto file = idm::get_unlocked<lv2_fs_object, lv2_file>(aio->fd);
+	fs_aio_manager(const fs_aio_manager&) = delete;
+	fs_aio_manager& operator=(const fs_aio_manager&) = delete;
 
-			if (!file || (type == 1 && file->flags & CELL_FS_O_WRONLY) || (type == 2 && !(file->flags & CELL_FS_O_ACCMODE)))
-			{
-			}
-			else if (std::lock_guard lock(file->mp->mutex); file->file)
-			{
-				const auto old_pos = file->file.pos(); file->file.seek(aio->offset);
+	static bool saveable(bool /*is_writing*/) noexcept
+	{
+		return GET_SERIALIZATION_VERSION(lv2_fs) >= 3;
+	}
 
-				result = type == 2
-					? file->op_write(aio->buf, aio->size)
-					: file->op_read(aio->buf, aio->size);
+	fs_aio_manager(utils::serial& ar) noexcept
+	{
+		if (GET_SERIALIZATION_VERSION(lv2_fs) < 3)
+		{
+			return;
+		}
 
-				file->file.seek(old_pos);
-				error = CELL_OK;
-			}
+		save(ar);
+	}
 
-			func(*this, aio, error, xid, result);
-			lv2_obj::sleep(*this);
-		}
+	void save(utils::serial& ar)
+	{
+		[[maybe_unused]] const s32 version = GET_OR_USE_SERIALIZATION_VERSION(ar.is_writing(), lv2_fs);
+		ar(init_ctr, ppu_id, queue_id);
 	}
 };
 
-struct fs_aio_manager
+// Completions of the lv2 I/O engine arrive as (aio << 32 | func, xid, error, size) and the callbacks run on this thread
+void fs_aio_event_entry(ppu_thread& ppu)
 {
-	std::shared_ptr<fs_aio_thread> thread;
+	ppu.state += cpu_flag::wait;
 
-	shared_mutex mutex;
-};
+	if (!ppu.loaded_from_savestate)
+	{
+		// Ensure awake
+		ppu.check_state();
+	}
 
-s32 cellFsAioInit(vm::cptr<char> mount_point)
-{
-	cellFs.warning("cellFsAioInit(mount_point=%s)", mount_point);
+	const u32 queue_id = g_fxo->get<fs_aio_manager>().queue_id;
 
-	// TODO: create AIO thread (if not exists) for specified mount point
-	cellFs.fatal("cellFsAio disabled, use LLE.");
+	while (sys_event_queue_receive(ppu, queue_id, vm::null, 0) == CELL_OK)
+	{
+		if (ppu.is_stopped())
+		{
+			ppu.state += cpu_flag::again;
+			return;
+		}
 
-	return CELL_OK;
+		ppu.check_state();
+
+		const u64 source = ppu.gpr[4];
+		const s32 xid = static_cast<s32>(ppu.gpr[5]);
+		const s32 error = static_cast<s32>(ppu.gpr[6]);
+		const u64 size = ppu.gpr[7];
+
+		const auto aio = vm::ptr<CellFsAio>::make(static_cast<u32>(source >> 32));
+		const auto func = fs_aio_cb_t::make(static_cast<u32>(source));
+
+		func(ppu, aio, error, xid, size);
+		ppu.state += cpu_flag::wait;
+	}
+
+	ppu_execute<&sys_ppu_thread_exit>(ppu, 0);
 }
 
-s32 cellFsAioFinish(vm::cptr<char> mount_point)
+error_code cellFsAioInit(ppu_thread& ppu, vm::cptr<char> mount_point)
 {
-	cellFs.warning("cellFsAioFinish(mount_point=%s)", mount_point);
+	cellFs.warning("cellFsAioInit(mount_point=%s)", mount_point);
+
+	// TODO: one AIO thread per mount point
+	auto& m = g_fxo->get<fs_aio_manager>();
 
-	// TODO: delete existing AIO thread for specified mount point
+	auto lock = lock_lv2_mutex_alike(m.mutex, &ppu);
+
+	if (m.init_ctr++ == 0)
+	{
+		vm::var<u64> _tid;
+		vm::var<u32> queue_id;
+		vm::var<char[]> _name = vm::make_str("_fs_aio_hndlr");
+
+		vm::var<sys_event_queue_attribute_t> attr;
+		attr->protocol = SYS_SYNC_PRIORITY;
+		attr->type = SYS_PPU_QUEUE;
+		attr->name_u64 = 0;
+
+		ensure(CELL_OK == sys_event_queue_create(ppu, queue_id, attr, 0, 127));
+		ppu.check_state();
+		m.queue_id = *queue_id;
+
+		ensure(CELL_OK == ppu_execute<&sys_ppu_thread_create>(ppu, +_tid, g_fxo->get<ppu_function_manager>().func_addr(FIND_FUNC(fs_aio_event_entry)), 0, 1000, 0x4000, SYS_PPU_THREAD_CREATE_JOINABLE, +_name));
+		ppu.check_state();
+		m.ppu_id = static_cast<u32>(*_tid);
+	}
 
 	return CELL_OK;
 }
 
-atomic_t<s32> g_fs_aio_id;
-
-s32 cellFsAioRead(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+error_code cellFsAioFinish(ppu_thread& ppu, vm::cptr<char> mount_point)
 {
-	cellFs.warning("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
-
-	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
+	cellFs.warning("cellFsAioFinish(mount_point=%s)", mount_point);
 
 	auto& m = g_fxo->get<fs_aio_manager>();
 
-	if (!m.thread)
+	auto lock = lock_lv2_mutex_alike(m.mutex, &ppu);
+
+	if (m.init_ctr == 1 && ppu.id == m.ppu_id)
 	{
-		return CELL_ENXIO;
+		// The handler thread cannot join itself
+		cellFs.error("cellFsAioFinish() called from an AIO callback");
+		return CELL_EDEADLK;
+	}
+
+	if (!m.init_ctr || --m.init_ctr)
+	{
+		return CELL_OK;
 	}
 
-	const s32 xid = (*id = ++g_fs_aio_id);
+	const u32 queue_id = std::exchange(m.queue_id, 0);
+	const u32 ppu_id = std::exchange(m.ppu_id, 0);
 
-	m.thread->cmd_list
-	({
-		{ 1, xid },
-		{ aio, func },
-	});
+	// Callbacks submitting more requests must not block on the lock while the handler is joined
+	lock.unlock();
 
+	// Pending completions are dropped with the queue
+	ensure(CELL_OK == sys_event_queue_destroy(ppu, queue_id, SYS_EVENT_QUEUE_DESTROY_FORCE));
+	ppu.check_state();
+	ensure(CELL_OK == sys_ppu_thread_join(ppu, ppu_id, +vm::var<u64>{}));
 	return CELL_OK;
 }
 
-s32 cellFsAioWrite(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
-{
-	cellFs.warning("cellFsAioWrite(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+atomic_t<s32> g_fs_aio_id;
 
-	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
+static error_code fs_aio_submit(bool write, vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	if (!aio || !id || !func)
+	{
+		return CELL_EFAULT;
+	}
 
 	auto& m = g_fxo->get<fs_aio_manager>();
 
-	if (!m.thread)
+	reader_lock lock(m.mutex);
+
+	if (!m.init_ctr)
 	{
 		return CELL_ENXIO;
 	}
 
-	const s32 xid = (*id = ++g_fs_aio_id);
+	const s32 xid = ++g_fs_aio_id;
 
-	m.thread->cmd_list
-	({
-		{ 2, xid },
-		{ aio, func },
-	});
+	const auto file = idm::get_unlocked<lv2_fs_object, lv2_file>(aio->fd);
 
+	if (const CellError error = lv2_file::submit_aio(file, write, aio->offset, aio->buf, aio->size, idm::get_unlocked<lv2_obj, lv2_event_queue>(m.queue_id), u64{aio.addr()} << 32 | func.addr(), xid))
+	{
+		return error;
+	}
+
+	*id = xid;
 	return CELL_OK;
 }
 
+error_code cellFsAioRead(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	cellFs.trace("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+
+	return fs_aio_submit(false, aio, id, func);
+}
+
+error_code cellFsAioWrite(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	cellFs.trace("cellFsAioWrite(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+
+	return fs_aio_submit(true, aio, id, func);
+}
+
 s32 cellFsAioCancel(s32 id)
 {
 	cellFs.todo("cellFsAioCancel(id=%d) -> CELL_EINVAL", id);
@@ -1116,4 +1188,6 @@ DECLARE(ppu_module_manager::cellFs)("sys_fs", []()
 	REG_FUNC(sys_fs, cellFsUtime);
 	REG_FUNC(sys_fs, cellFsWrite).flag(MFF_PERFECT);
 	REG_FUNC(sys_fs, cellFsWriteWithOffset);
+
+	REG_HIDDEN_FUNC(fs_aio_event_entry);
 });
@@ -8,6 +8,7 @@
 
 #include "Emu/Cell/lv2/sys_fs.h"
 #include "cellGifDec.h"
+#include "image_decode_cache.h"
 
 #include "util/asm.hpp"
 
@@ -489,95 +490,49 @@ error_code cellGifDecDecodeData(vm::ptr<GifDecoder> mainHandle, vm::cptr<GifStre
 	const u64 fileSize = subHandle->fileSize;
 	const CellGifDecOutParam& current_outParam = subHandle->outParam;
 
-	//Copy the GIF file to a buffer
-	std::unique_ptr<u8[]> gif(new u8[fileSize]);
+	// Read the GIF file (buffer sources are decoded in place)
+	std::vector<u8> gif;
+	std::span<const u8> encoded;
 
 	switch (subHandle->src.srcSelect)
 	{
 	case CELL_GIFDEC_BUFFER:
-		std::memcpy(gif.get(), subHandle->src.streamPtr.get_ptr(), fileSize);
+		encoded = {vm::_ptr<const u8>(subHandle->src.streamPtr.addr()), fileSize};
 		break;
 
 	case CELL_GIFDEC_FILE:
 	{
 		auto file = idm::get_unlocked<lv2_fs_object, lv2_file>(fd);
+		gif.resize(fileSize);
 		file->file.seek(0);
-		file->file.read(gif.get(), fileSize);
+		file->file.read(gif.data(), fileSize);
+		encoded = gif;
 		break;
 	}
 	default: break; // TODO
 	}
 
-	//Decode GIF file. (TODO: Is there any faster alternative? Can we do it without external libraries?)
-	int width, height, actual_components;
-	auto image = std::unique_ptr<unsigned char,decltype(&::free)>
-		(
-			stbi_load_from_memory(gif.get(), ::narrow<int>(fileSize), &width, &height, &actual_components, 4),
-			&::free
-		);
+	//Decode GIF file (or reuse the image decoded from the same data)
+	const auto image = g_fxo->get<image_decode_cache>().decode(encoded);
 
 	if (!image)
 		return CELL_GIFDEC_ERROR_STREAM_FORMAT;
 
+	const int width = image->width;
+	const int height = image->height;
 	const int bytesPerLine = static_cast<int>(dataCtrlParam->outputBytesPerLine);
 	constexpr char nComponents = 4;
-	const u32 image_size = width * height * nComponents;
+	const int row_size = width * nComponents;
 
 	switch(current_outParam.outputColorSpace)
 	{
 	case CELL_GIFDEC_RGBA:
-	{
-		if (bytesPerLine > width * nComponents) // Check if we need padding
-		{
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * i;
-				memcpy(&data[dstOffset], &image.get()[srcOffset], linesize);
-			}
-		}
-		else
-		{
-			memcpy(data.get_ptr(), image.get(), image_size);
-		}
-		break;
-	}
 	case CELL_GIFDEC_ARGB:
 	{
-		if (bytesPerLine > width * nComponents) // Check if we need padding
-		{
-			//TODO: find out if we can't do padding without an extra copy
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			const auto output = std::make_unique<char[]>(linesize);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * i;
-				for (int j = 0; j < linesize; j += nComponents)
-				{
-					output[j + 0] = image.get()[srcOffset + j + 3];
-					output[j + 1] = image.get()[srcOffset + j + 0];
-					output[j + 2] = image.get()[srcOffset + j + 1];
-					output[j + 3] = image.get()[srcOffset + j + 2];
-				}
-				std::memcpy(&data[dstOffset], output.get(), linesize);
-			}
-		}
-		else
-		{
-			const auto img = std::make_unique<uint[]>(image_size);
-			uint* source_current = reinterpret_cast<uint*>(image.get());
-			uint* dest_current = img.get();
-			for (uint i = 0; i < image_size / nComponents; i++)
-			{
-				uint val = *source_current;
-				*dest_current = (val >> 24) | (val << 8); // set alpha (A8) as leftmost byte
-				source_current++;
-				dest_current++;
-			}
-			std::memcpy(data.get_ptr(), img.get(), image_size);
-		}
+		// Convert directly into the output buffer, check if we need padding
+		const bool padding = bytesPerLine > row_size;
+		const int linesize = padding ? std::min(bytesPerLine, row_size) : row_size;
+		image_decode_cache::write_rows(image->rgba.get(), row_size, height, data.get_ptr(), padding ? bytesPerLine : row_size, linesize, current_outParam.outputColorSpace == CELL_GIFDEC_ARGB, false);
 		break;
 	}
 	default:
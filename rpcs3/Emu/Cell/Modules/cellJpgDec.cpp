@@ -8,6 +8,7 @@
 
 #include "Emu/Cell/lv2/sys_fs.h"
 #include "cellJpgDec.h"
+#include "image_decode_cache.h"
 
 #include "util/asm.hpp"
 
@@ -212,36 +213,36 @@ error_code cellJpgDecDecodeData(u32 mainHandle, u32 subHandle, vm::ptr<u8> data,
 	const u64& fileSize = subHandle_data->fileSize;
 	const CellJpgDecOutParam& current_outParam = subHandle_data->outParam;
 
-	//Copy the JPG file to a buffer
-	std::unique_ptr<u8[]> jpg(new u8[fileSize]);
+	// Read the JPG file (buffer sources are decoded in place)
+	std::vector<u8> jpg;
+	std::span<const u8> encoded;
 
 	switch (subHandle_data->src.srcSelect)
 	{
 	case CELL_JPGDEC_BUFFER:
-		std::memcpy(jpg.get(), vm::base(subHandle_data->src.streamPtr), fileSize);
+		encoded = {vm::_ptr<const u8>(subHandle_data->src.streamPtr), fileSize};
 		break;
 
 	case CELL_JPGDEC_FILE:
 	{
 		auto file = idm::get_unlocked<lv2_fs_object, lv2_file>(fd);
+		jpg.resize(fileSize);
 		file->file.seek(0);
-		file->file.read(jpg.get(), fileSize);
+		file->file.read(jpg.data(), fileSize);
+		encoded = jpg;
 		break;
 	}
 	default: break; // TODO
 	}
 
-	//Decode JPG file. (TODO: Is there any faster alternative? Can we do it without external libraries?)
-	int width, height, actual_components;
-	auto image = std::unique_ptr<unsigned char,decltype(&::free)>
-		(
-			stbi_load_from_memory(jpg.get(), ::narrow<int>(fileSize), &width, &height, &actual_components, 4),
-			&::free
-		);
+	//Decode JPG file (or reuse the image decoded from the same data)
+	const auto image = g_fxo->get<image_decode_cache>().decode(encoded);
 
 	if (!image)
 		return CELL_JPGDEC_ERROR_STREAM_FORMAT;
 
+	const int width = image->width;
+	const int height = image->height;
 	const bool flip = current_outParam.outputMode == CELL_JPGDEC_BOTTOM_TO_TOP;
 	const int bytesPerLine = static_cast<int>(dataCtrlParam->outputBytesPerLine);
 	usz image_size = width * height;
@@ -250,62 +251,16 @@ error_code cellJpgDecDecodeData(u32 mainHandle, u32 subHandle, vm::ptr<u8> data,
 	{
 	case CELL_JPG_RGB:
 	case CELL_JPG_RGBA:
-	{
-		const char nComponents = current_outParam.outputColorSpace == CELL_JPG_RGBA ? 4 : 3;
-		image_size *= nComponents;
-		if (bytesPerLine > width * nComponents || flip) //check if we need padding
-		{
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * (flip ? height - i - 1 : i);
-				memcpy(&data[dstOffset], &image.get()[srcOffset], linesize);
-			}
-		}
-		else
-		{
-			memcpy(data.get_ptr(), image.get(), image_size);
-		}
-		break;
-	}
 	case CELL_JPG_ARGB:
 	{
-		constexpr int nComponents = 4;
+		const char nComponents = current_outParam.outputColorSpace == CELL_JPG_RGB ? 3 : 4;
+		const int row_size = width * nComponents;
 		image_size *= nComponents;
-		if (bytesPerLine > width * nComponents || flip) //check if we need padding
-		{
-			//TODO: Find out if we can't do padding without an extra copy
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			const auto output = std::make_unique<char[]>(linesize);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * (flip ? height - i - 1 : i);
-				for (int j = 0; j < linesize; j += nComponents)
-				{
-					output[j + 0] = image.get()[srcOffset + j + 3];
-					output[j + 1] = image.get()[srcOffset + j + 0];
-					output[j + 2] = image.get()[srcOffset + j + 1];
-					output[j + 3] = image.get()[srcOffset + j + 2];
-				}
-				std::memcpy(&data[dstOffset], output.get(), linesize);
-			}
-		}
-		else
-		{
-			const auto img = std::make_unique<uint[]>(image_size);
-			uint* source_current = reinterpret_cast<uint*>(image.get());
-			uint* dest_current = img.get();
-			for (uint i = 0; i < image_size / nComponents; i++)
-			{
-				uint val = *source_current;
-				*dest_current = (val >> 24) | (val << 8); // set alpha (A8) as leftmost byte
-				source_current++;
-				dest_current++;
-			}
-			std::memcpy(data.get_ptr(), img.get(), image_size);
-		}
+
+		// Convert directly into the output buffer, check if we need padding
+		const bool padding = bytesPerLine > row_size || flip;
+		const int linesize = padding ? std::min(bytesPerLine, row_size) : row_size;
+		image_decode_cache::write_rows(image->rgba.get(), row_size, height, data.get_ptr(), padding ? bytesPerLine : row_size, linesize, current_outParam.outputColorSpace == CELL_JPG_ARGB, flip);
 		break;
 	}
 	case CELL_JPG_GRAYSCALE:
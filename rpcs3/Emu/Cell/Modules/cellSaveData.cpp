@@ -2107,13 +2107,11 @@ static NEVER_INLINE error_code savedata_op(ppu_thread& ppu, u32 operation, u32 v
 			if (auto file = pair.second.release())
 			{
 				auto&& fvec = static_cast<fs::container_stream<std::vector<uchar>>&>(*file);
-#ifdef _WIN32
+
+				// Commit syncs the file contents before it is renamed into place
 				fs::pending_file f(new_path + vfs::escape(pair.first));
 				f.file.write(fvec.obj);
 				ensure(f.commit());
-#else
-				ensure(fs::write_file(new_path + vfs::escape(pair.first), fs::rewrite, fvec.obj));
-#endif
 			}
 		}
 
@@ -2123,9 +2121,13 @@ static NEVER_INLINE error_code savedata_op(ppu_thread& ppu, u32 operation, u32 v
 			fs::utime(new_path + vfs::escape(pair.first), pair.second.first, pair.second.second);
 		}
 
-		// Remove old backup
+		// Remove old backup, make the file entries of the new savedata durable (instead of syncing the entire host filesystem)
 		fs::remove_all(old_path);
-		fs::sync();
+
+		if (!fs::sync_dir(new_path))
+		{
+			cellSaveData.error("savedata_op(): Failed to sync directory %s (%s)", new_path, fs::g_tls_error);
+		}
 
 		// Backup old savedata
 		if (!vfs::host::rename(dir_path, old_path, &g_mp_sys_dev_hdd0, false))
@@ -2142,6 +2144,12 @@ static NEVER_INLINE error_code savedata_op(ppu_thread& ppu, u32 operation, u32 v
 
 		// Remove backup again (TODO: may be changed to persistent backup implementation)
 		fs::remove_all(old_path);
+
+		// Make the renames durable
+		if (!fs::sync_dir(base_dir))
+		{
+			cellSaveData.error("savedata_op(): Failed to sync directory %s (%s)", base_dir, fs::g_tls_error);
+		}
 	}
 
 	if (show_auto_indicator)
@@ -5,6 +5,7 @@
 #include "Emu/Cell/lv2/sys_sync.h"
 #include "Emu/Cell/lv2/sys_ppu_thread.h"
 #include "Emu/Cell/lv2/sys_process.h"
+#include "Emu/Cell/timers.hpp"
 #include "Emu/savestate_utils.hpp"
 #include "sysPrxForUser.h"
 #include "util/media_utils.h"
@@ -141,12 +142,134 @@ struct vdec_cmd
 	CellVdecAuInfo au{};
 };
 
+// Free list of AVFrame objects, recycled instead of being allocated for every picture
+struct vdec_frame_pool
+{
+	static constexpr usz max_frames = 64;
+
+	std::mutex mutex;
+	std::vector<AVFrame*> frames;
+
+	vdec_frame_pool() = default;
+
+	vdec_frame_pool(const vdec_frame_pool&) = delete;
+
+	vdec_frame_pool& operator=(const vdec_frame_pool&) = delete;
+
+	~vdec_frame_pool()
+	{
+		for (AVFrame*& frame : frames)
+		{
+			av_frame_free(&frame);
+		}
+	}
+
+	AVFrame* alloc()
+	{
+		{
+			std::lock_guard lock(mutex);
+
+			if (!frames.empty())
+			{
+				AVFrame* frame = frames.back();
+				frames.pop_back();
+				return frame;
+			}
+		}
+
+		return av_frame_alloc();
+	}
+
+	void free(AVFrame* frame)
+	{
+		av_frame_unref(frame);
+
+		{
+			std::lock_guard lock(mutex);
+
+			if (frames.size() < max_frames)
+			{
+				frames.push_back(frame);
+				return;
+			}
+		}
+
+		av_frame_free(&frame);
+	}
+};
+
+// Opened decoder contexts of closed handles, reused so that cellVdecOpen can avoid avcodec_open2 (serialized by g_mutex_avcodec_open2)
+struct vdec_context_pool
+{
+	static constexpr usz max_contexts = 4;
+
+	std::mutex mutex;
+	std::vector<std::pair<u64, AVCodecContext*>> contexts;
+
+	~vdec_context_pool()
+	{
+		for (auto& [key, ctx] : contexts)
+		{
+			avcodec_free_context(&ctx);
+		}
+	}
+
+	// Key: codec type and thread count
+	AVCodecContext* take(u64 key)
+	{
+		std::lock_guard lock(mutex);
+
+		for (auto it = contexts.begin(); it != contexts.end(); it++)
+		{
+			if (it->first == key)
+			{
+				AVCodecContext* ctx = it->second;
+				contexts.erase(it);
+				return ctx;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void put(u64 key, AVCodecContext* ctx)
+	{
+		avcodec_flush_buffers(ctx);
+
+		{
+			std::lock_guard lock(mutex);
+
+			if (contexts.size() < max_contexts)
+			{
+				contexts.emplace_back(key, ctx);
+				return;
+			}
+		}
+
+		avcodec_free_context(&ctx);
+	}
+
+	static vdec_context_pool& get()
+	{
+		static vdec_context_pool pool;
+		return pool;
+	}
+};
+
 struct vdec_frame
 {
 	struct frame_dtor
 	{
+		vdec_frame_pool* pool = nullptr;
+
 		void operator()(AVFrame* data) const
 		{
+			if (pool)
+			{
+				pool->free(data);
+				return;
+			}
+
 			av_frame_unref(data);
 			av_frame_free(&data);
 		}
@@ -188,6 +311,14 @@ struct vdec_context final
 	const AVCodecDescriptor* codec_desc{};
 	AVCodecContext* ctx{};
 	SwsContext* sws{};
+	u64 ctx_key{}; // vdec_context_pool key
+
+	// Per-handle decoding time statistics (in microseconds)
+	u64 stat_au_count{};
+	u64 stat_decode_time{};
+	u64 stat_decode_max{};
+
+	vdec_frame_pool frame_pool; // Must be destroyed after the frame queue
 
 	shared_mutex mutex; // Used for 'out' queue (TODO)
 
@@ -254,6 +385,16 @@ struct vdec_context final
 			fmt::throw_exception("avcodec_descriptor_get() failed (type=0x%x)", type);
 		}
 
+		const int thread_count = g_cfg.video.video_decoder_threads;
+
+		ctx_key = u64{static_cast<u32>(type)} | u64{static_cast<u32>(thread_count)} << 32;
+
+		if ((ctx = vdec_context_pool::get().take(ctx_key)))
+		{
+			seq_state = sequence_state::dormant;
+			return;
+		}
+
 		ctx = avcodec_alloc_context3(codec);
 
 		if (!ctx)
@@ -261,6 +402,10 @@ struct vdec_context final
 			fmt::throw_exception("avcodec_alloc_context3() failed (type=0x%x)", type);
 		}
 
+		// Slice threading only: frame threading delays pictures past their AUDONE
+		ctx->thread_count = thread_count;
+		ctx->thread_type = FF_THREAD_SLICE;
+
 		AVDictionary* opts = nullptr;
 
 		std::lock_guard lock(g_mutex_avcodec_open2);
@@ -288,7 +433,12 @@ struct vdec_context final
 
 	~vdec_context()
 	{
-		avcodec_free_context(&ctx);
+		if (stat_au_count)
+		{
+			cellVdec.notice("Decoding statistics (handle=0x%x): %u AUs, average %uus, max %uus", handle, stat_au_count, stat_decode_time / stat_au_count, stat_decode_max);
+		}
+
+		vdec_context_pool::get().put(ctx_key, ctx);
 		sws_freeContext(sws);
 	}
 
@@ -405,6 +555,8 @@ struct vdec_context final
 				{
 					cellVdec.trace("AU decoding: handle=0x%x, seq_id=%d, cmd_id=%d, size=0x%x, pts=0x%llx, dts=0x%llx, userdata=0x%llx", handle, cmd->seq_id, cmd->id, au_size, au_pts, au_dts, au_usrd);
 
+					const u64 decode_start = get_system_time();
+
 					if (int ret = avcodec_send_packet(ctx, &packet); ret < 0)
 					{
 						fmt::throw_exception("AU queuing error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
@@ -416,7 +568,7 @@ struct vdec_context final
 						vdec_frame frame;
 						frame.seq_id = cmd->seq_id;
 						frame.cmd_id = cmd->id;
-						frame.avf.reset(av_frame_alloc());
+						frame.avf = {frame_pool.alloc(), vdec_frame::frame_dtor{&frame_pool}};
 
 						if (!frame.avf)
 						{
@@ -552,6 +704,11 @@ struct vdec_context final
 
 						decoded_frames.push_back(std::move(frame));
 					}
+
+					const u64 decode_time = get_system_time() - decode_start;
+					stat_au_count++;
+					stat_decode_time += decode_time;
+					stat_decode_max = std::max(stat_decode_max, decode_time);
 				}
 
 				if (thread_ctrl::state() != thread_state::aborting)
@@ -1261,12 +1418,10 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 
 		AVPixelFormat out_f = AV_PIX_FMT_YUV420P;
 
-		std::unique_ptr<u8[]> alpha_plane;
-
 		switch (const u32 type = format->formatType)
 		{
-		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; alpha_plane.reset(new u8[w * h]); break;
-		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; alpha_plane.reset(new u8[w * h]); break;
+		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; break;
+		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; break;
 		case CELL_VDEC_PICFMT_UYVY422_ILV: out_f = AV_PIX_FMT_UYVY422; break;
 		case CELL_VDEC_PICFMT_YUV420_PLANAR: out_f = AV_PIX_FMT_YUV420P; break;
 		default:
@@ -1275,50 +1430,56 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 		}
 		}
 
-		// TODO: color matrix
-
-		if (alpha_plane)
+		if (frame->format != AV_PIX_FMT_YUV420P && frame->format != AV_PIX_FMT_YUVJ420P)
 		{
-			std::memset(alpha_plane.get(), format->alpha, w * h);
+			fmt::throw_exception("cellVdecGetPictureExt: Unknown frame format (%d)", frame->format);
 		}
 
-		AVPixelFormat in_f = AV_PIX_FMT_YUV420P;
+		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, out_f=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +out_f, format->alpha, format->colorMatrixType);
+
+		// TODO:
+		// It's possible that we need to align the pitch to 128 here.
+		// PS HOME seems to rely on this somehow in certain cases.
 
-		switch (frame->format)
+		if (out_f == AV_PIX_FMT_RGBA || out_f == AV_PIX_FMT_ARGB)
 		{
-		case AV_PIX_FMT_YUVJ420P:
-			cellVdec.error("cellVdecGetPictureExt: experimental AVPixelFormat (handle=0x%x, seq_id=%d, cmd_id=%d, format=%d). This may cause suboptimal video quality.", handle, frame.seq_id, frame.cmd_id, frame->format);
-			[[fallthrough]];
-		case AV_PIX_FMT_YUV420P:
-			in_f = alpha_plane ? AV_PIX_FMT_YUVA420P : static_cast<AVPixelFormat>(frame->format);
-			break;
-		default:
-			fmt::throw_exception("cellVdecGetPictureExt: Unknown frame format (%d)", frame->format);
+			// Convert directly into the guest buffer with a constant alpha
+			const utils::yuv420_picture src
+			{
+				.y = frame->data[0],
+				.u = frame->data[1],
+				.v = frame->data[2],
+				.y_pitch = static_cast<u32>(frame->linesize[0]),
+				.uv_pitch = static_cast<u32>(frame->linesize[1]),
+				.width = static_cast<u32>(w),
+				.height = static_cast<u32>(h),
+			};
+
+			const bool full_range = frame->format == AV_PIX_FMT_YUVJ420P || frame->color_range == AVCOL_RANGE_JPEG;
+
+			utils::convert_yuv420_to_rgba32(src, outBuff.get_ptr(), w * 4, format->alpha, out_f == AV_PIX_FMT_ARGB, format->colorMatrixType == CELL_VDEC_COLOR_MATRIX_TYPE_BT709, full_range);
+			return CELL_OK;
 		}
 
-		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, in_f=%d, out_f=%d, alpha_plane=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +in_f, +out_f, !!alpha_plane, format->alpha, format->colorMatrixType);
+		if (frame->format == AV_PIX_FMT_YUVJ420P)
+		{
+			cellVdec.error("cellVdecGetPictureExt: experimental AVPixelFormat (handle=0x%x, seq_id=%d, cmd_id=%d, format=%d). This may cause suboptimal video quality.", handle, frame.seq_id, frame.cmd_id, frame->format);
+		}
 
-		vdec->sws = sws_getCachedContext(vdec->sws, w, h, in_f, w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
+		// YUV420P or UYVY422
+		vdec->sws = sws_getCachedContext(vdec->sws, w, h, static_cast<AVPixelFormat>(frame->format), w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
 
-		u8* in_data[4] = { frame->data[0], frame->data[1], frame->data[2], alpha_plane.get() };
-		int in_line[4] = { frame->linesize[0], frame->linesize[1], frame->linesize[2], w * 1 };
+		u8* in_data[4] = { frame->data[0], frame->data[1], frame->data[2] };
+		int in_line[4] = { frame->linesize[0], frame->linesize[1], frame->linesize[2] };
 		u8* out_data[4] = { outBuff.get_ptr() };
-		int out_line[4] = { w * 4 }; // RGBA32 or ARGB32
+		int out_line[4] = {};
 
-		// TODO:
-		// It's possible that we need to align the pitch to 128 here.
-		// PS HOME seems to rely on this somehow in certain cases.
+		out_data[1] = out_data[0] + w * h;
+		out_data[2] = out_data[0] + w * h * 5 / 4;
 
-		if (!alpha_plane)
+		if (const int ret = av_image_fill_linesizes(out_line, out_f, w); ret < 0)
 		{
-			// YUV420P or UYVY422
-			out_data[1] = out_data[0] + w * h;
-			out_data[2] = out_data[0] + w * h * 5 / 4;
-
-			if (const int ret = av_image_fill_linesizes(out_line, out_f, w); ret < 0)
-			{
-				fmt::throw_exception("cellVdecGetPictureExt: av_image_fill_linesizes failed (handle=0x%x, seq_id=%d, cmd_id=%d, ret=0x%x): %s", handle, frame.seq_id, frame.cmd_id, ret, utils::av_error_to_string(ret));
-			}
+			fmt::throw_exception("cellVdecGetPictureExt: av_image_fill_linesizes failed (handle=0x%x, seq_id=%d, cmd_id=%d, ret=0x%x): %s", handle, frame.seq_id, frame.cmd_id, ret, utils::av_error_to_string(ret));
 		}
 
 		sws_scale(vdec->sws, in_data, in_line, 0, h, out_data, out_line);
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
+#include "util/media_utils.h"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -232,6 +233,11 @@ error_code cellVpostExec(u32 handle, vm::cptr<u8> inPicBuff, vm::cptr<CellVpostC
 	u32 ow = ctrlParam->outWidth;
 	u32 oh = ctrlParam->outHeight;
 
+	if (!w || !h || !ow || !oh)
+	{
+		return CELL_VPOST_ERROR_E_ARG_CTRL_INVALID;
+	}
+
 	//ctrlParam->inWindow; // ignored
 	if (ctrlParam->inWindow.x) cellVpost.notice("*** inWindow.x = %d", ctrlParam->inWindow.x);
 	if (ctrlParam->inWindow.y) cellVpost.notice("*** inWindow.y = %d", ctrlParam->inWindow.y);
@@ -270,18 +276,33 @@ error_code cellVpostExec(u32 handle, vm::cptr<u8> inPicBuff, vm::cptr<CellVpostC
 	picInfo->reserved1 = 0;
 	picInfo->reserved2 = 0;
 
-	//u64 stamp0 = get_guest_system_time();
-	std::unique_ptr<u8[]> pA(new u8[w*h]);
-
-	memset(pA.get(), ctrlParam->outAlpha, w*h);
+	if (w == ow && h == oh)
+	{
+		// No scaling required: convert directly into the output picture
+		const utils::yuv420_picture src
+		{
+			.y = inPicBuff.get_ptr(),
+			.u = inPicBuff.get_ptr() + w * h,
+			.v = inPicBuff.get_ptr() + w * h * 5 / 4,
+			.y_pitch = w,
+			.uv_pitch = w / 2,
+			.width = w,
+			.height = h,
+		};
+
+		utils::convert_yuv420_to_rgba32(src, outPicBuff.get_ptr(), ow * 4, ctrlParam->outAlpha, false, ctrlParam->inColorMatrix == CELL_VPOST_COLOR_MATRIX_BT709, ctrlParam->inQuantRange == CELL_VPOST_QUANT_RANGE_FULL);
+		return CELL_OK;
+	}
 
-	//u64 stamp1 = get_guest_system_time();
+	// Constant alpha plane, only refilled when the picture size or the alpha value changes
+	if (vpost->alpha_plane.size() != w * h || vpost->alpha_plane[0] != ctrlParam->outAlpha)
+	{
+		vpost->alpha_plane.assign(w * h, ctrlParam->outAlpha);
+	}
 
 	vpost->sws = sws_getCachedContext(vpost->sws, w, h, AV_PIX_FMT_YUVA420P, ow, oh, AV_PIX_FMT_RGBA, SWS_BILINEAR, nullptr, nullptr, nullptr);
 
-	//u64 stamp2 = get_guest_system_time();
-
-	const u8* in_data[4] = { &inPicBuff[0], &inPicBuff[w * h], &inPicBuff[w * h * 5 / 4], pA.get() };
+	const u8* in_data[4] = { &inPicBuff[0], &inPicBuff[w * h], &inPicBuff[w * h * 5 / 4], vpost->alpha_plane.data() };
 	int ws = w;
 	int in_line[4] = { ws, ws/2, ws/2, ws };
 	u8* out_data[4] = { outPicBuff.get_ptr(), nullptr, nullptr, nullptr };
@@ -289,8 +310,6 @@ error_code cellVpostExec(u32 handle, vm::cptr<u8> inPicBuff, vm::cptr<CellVpostC
 
 	sws_scale(vpost->sws, in_data, in_line, 0, h, out_data, out_line);
 
-	//ConLog.Write("cellVpostExec() perf (access=%d, getContext=%d, scale=%d, finalize=%d)",
-		//stamp1 - stamp0, stamp2 - stamp1, stamp3 - stamp2, get_guest_system_time() - stamp3);
 	return CELL_OK;
 }
 
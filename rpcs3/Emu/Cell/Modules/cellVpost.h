@@ -345,6 +345,7 @@ public:
 	const bool to_rgba;
 
 	SwsContext* sws{};
+	std::vector<u8> alpha_plane; // Used by the scaling path
 
 	VpostInstance(bool rgba)
 		: to_rgba(rgba)
@@ -0,0 +1,76 @@
+#include "stdafx.h"
+#include "image_decode_cache.h"
+
+#include "Emu/system_config.h"
+#include "Crypto/sha1.h"
+
+// STB_IMAGE_IMPLEMENTATION is already defined in stb_image.cpp
+#include <stb_image.h>
+
+LOG_CHANNEL(sys_log, "SYS");
+
+std::shared_ptr<const image_decode_cache::image> image_decode_cache::decode(std::span<const u8> encoded)
+{
+	const usz budget = usz{g_cfg.core.image_decode_cache_size} * 1024 * 1024;
+
+	key_t key{};
+
+	if (budget)
+	{
+		sha1(encoded.data(), encoded.size(), key.data());
+
+		std::lock_guard lock(mutex);
+
+		if (auto found = images.find(key); found != images.end())
+		{
+			hits++;
+			lru.splice(lru.begin(), lru, found->second.second);
+			return found->second.first;
+		}
+	}
+
+	auto result = std::make_shared<image>();
+
+	int actual_components;
+	result->rgba.reset(stbi_load_from_memory(encoded.data(), ::narrow<int>(encoded.size()), &result->width, &result->height, &actual_components, 4));
+
+	if (!result->rgba)
+	{
+		return nullptr;
+	}
+
+	if (!budget || result->size() > budget)
+	{
+		return result;
+	}
+
+	std::lock_guard lock(mutex);
+
+	misses++;
+
+	if (auto [found, inserted] = images.try_emplace(key); inserted)
+	{
+		lru.push_front(key);
+		found->second = {result, lru.begin()};
+		memory_used += result->size();
+
+		// Evict least recently used images
+		while (memory_used > budget)
+		{
+			const auto old = images.find(lru.back());
+			memory_used -= old->second.first->size();
+			images.erase(old);
+			lru.pop_back();
+		}
+	}
+
+	return result;
+}
+
+image_decode_cache::~image_decode_cache()
+{
+	if (hits)
+	{
+		sys_log.notice("Image decode cache: %u hits, %u misses, %u bytes used", hits.load(), misses.load(), memory_used);
+	}
+}
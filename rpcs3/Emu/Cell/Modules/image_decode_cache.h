@@ -0,0 +1,75 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "util/atomic.hpp"
+#include "Utilities/mutex.h"
+
+#include <array>
+#include <bit>
+#include <list>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Images decoded by stb_image (RGBA8), shared by cellJpgDec and cellGifDec and keyed by the SHA-1 of the encoded data
+struct image_decode_cache
+{
+	struct image
+	{
+		std::unique_ptr<u8, decltype(&::free)> rgba{nullptr, &::free};
+		s32 width = 0;
+		s32 height = 0;
+
+		usz size() const
+		{
+			return usz{static_cast<u32>(width)} * static_cast<u32>(height) * 4;
+		}
+	};
+
+	using key_t = std::array<u8, 20>;
+
+	shared_mutex mutex;
+	std::map<key_t, std::pair<std::shared_ptr<const image>, std::list<key_t>::iterator>> images;
+	std::list<key_t> lru; // Most recently used first
+	usz memory_used = 0;
+
+	atomic_t<u64> hits = 0;
+	atomic_t<u64> misses = 0;
+
+	// Decode the image or return the cached result (nullptr on decoding failure)
+	std::shared_ptr<const image> decode(std::span<const u8> encoded);
+
+	~image_decode_cache();
+
+	// Write rows of 4-byte pixels into the guest buffer, swizzling RGBA to ARGB if requested
+	static void write_rows(const u8* src, u32 src_pitch, u32 height, u8* dst, u32 dst_pitch, u32 linesize, bool argb, bool flip)
+	{
+		for (u32 i = 0; i < height; i++)
+		{
+			const u8* src_row = src + usz{src_pitch} * (flip ? height - i - 1 : i);
+			u8* dst_row = dst + usz{dst_pitch} * i;
+
+			if (!argb)
+			{
+				std::memcpy(dst_row, src_row, linesize);
+				continue;
+			}
+
+			u32 j = 0;
+
+			for (; j + 4 <= linesize; j += 4)
+			{
+				u32 val;
+				std::memcpy(&val, src_row + j, 4);
+				val = std::rotl(val, 8); // Set alpha (A8) as leftmost byte
+				std::memcpy(dst_row + j, &val, 4);
+			}
+
+			for (; j < linesize; j++)
+			{
+				dst_row[j] = src_row[(j & ~3u) + ((j + 3) & 3)];
+			}
+		}
+	}
+};
@@ -572,45 +572,156 @@ extern void utilize_spu_data_segment(u32 vaddr, const void* ls_data_vaddr, u32 s
 	std::vector<u32> data(size / 4);
 	std::memcpy(data.data(), ls_data_vaddr, size);
 
-	spu_cache::precompile_data_t obj{vaddr, std::move(data)};
+	be_t<u64> hash_start;
+	{
+		sha1_context ctx;
+		u8 output[20];
 
-	obj.funcs = spu_thread::discover_functions(vaddr, { reinterpret_cast<const u8*>(ls_data_vaddr), size }, vaddr != 0, umax);
+		sha1_starts(&ctx);
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&vaddr), sizeof(vaddr));
+		sha1_update(&ctx, reinterpret_cast<const u8*>(data.data()), size);
+		sha1_finish(&ctx, output);
+		std::memcpy(&hash_start, output, sizeof(hash_start));
+	}
 
-	if (obj.funcs.empty())
+	// Function discovery is deferred to spu_cache::initialize where it runs in parallel
+	g_fxo->get<spu_cache>().precompile_funcs.push(spu_cache::precompile_data_t{vaddr, std::move(data), {}, hash_start});
+}
+
+// Fill precompile_data_t::funcs for every segment, using the persistent discovery cache where possible
+static void discover_spu_precompile_funcs(std::vector<spu_cache::precompile_data_t>& data_list, const std::string& ppu_cache)
+{
+	if (data_list.empty())
 	{
-		// Nothing to add
 		return;
 	}
 
-	if (spu_log.notice)
+	// Discovery cache file (segment hash + function list)
+	fs::file file(ppu_cache + "spu-discovery-v1.dat", fs::read + fs::write + fs::create + fs::append);
+
+	struct entry_info_t
+	{
+		be_t<u64> hash;
+		be_t<u32> count;
+	};
+
+	std::unordered_map<u64, std::vector<u32>> known_funcs;
+
+	if (file)
 	{
-		std::string to_log;
+		file.seek(0);
 
-		for (usz i = 0; i < obj.funcs.size(); i++)
+		entry_info_t info{};
+
+		while (file.read(info))
 		{
-			if (i == 0 && obj.funcs.size() < 4)
+			std::vector<u32> funcs;
+
+			if (info.count > SPU_LS_SIZE / 4 || !file.read(funcs, info.count))
 			{
-				// Skip newline in this case
-				to_log += ' ';
+				// Truncated or broken entry
+				break;
 			}
-			else if (i % 4 == 0)
+
+			known_funcs.emplace(info.hash, std::move(funcs));
+		}
+	}
+
+	std::vector<usz> pending;
+
+	for (usz i = 0; i < data_list.size(); i++)
+	{
+		if (auto found = known_funcs.find(data_list[i].hash); found != known_funcs.end())
+		{
+			data_list[i].funcs = std::move(found->second);
+		}
+		else
+		{
+			pending.push_back(i);
+		}
+	}
+
+	if (!pending.empty())
+	{
+		atomic_t<usz> pending_index = 0;
+
+		const named_thread_group workers("SPU Discovery "sv, std::min<u32>(rpcs3::utils::get_max_threads(), ::size32(pending)), [&]()
+		{
+			for (usz i = pending_index++; i < pending.size() && !Emu.IsStopped(); i = pending_index++)
 			{
-				fmt::append(to_log, "\n[%02u] ", i / 8);
+				auto& sec = data_list[pending[i]];
+
+				sec.funcs = spu_thread::discover_functions(sec.vaddr, { reinterpret_cast<const u8*>(sec.inst_data.data()), sec.inst_data.size() * 4 }, sec.vaddr != 0, umax);
 			}
-			else
+		});
+	}
+
+	if (Emu.IsStopped())
+	{
+		// Results may be incomplete, do not store them
+		return;
+	}
+
+	if (file)
+	{
+		for (usz i : pending)
+		{
+			const auto& sec = data_list[i];
+
+			const entry_info_t info{sec.hash, ::size32(sec.funcs)};
+
+			const fs::iovec_clone gather[2]
 			{
-				to_log += ", ";
-			}
+				{&info, sizeof(info)},
+				{sec.funcs.data(), sec.funcs.size() * 4}
+			};
 
-			fmt::append(to_log, "0x%05x", obj.funcs[i]);
+			file.write_gather(gather, 2);
+		}
+	}
+
+	usz total_funcs = 0;
+
+	for (const auto& sec : data_list)
+	{
+		if (sec.funcs.empty())
+		{
+			continue;
 		}
 
-		spu_log.notice("Found SPU function(s) at:%s", to_log);
+		total_funcs += sec.funcs.size();
+
+		if (spu_log.notice)
+		{
+			std::string to_log;
+
+			for (usz i = 0; i < sec.funcs.size(); i++)
+			{
+				if (i == 0 && sec.funcs.size() < 4)
+				{
+					// Skip newline in this case
+					to_log += ' ';
+				}
+				else if (i % 4 == 0)
+				{
+					fmt::append(to_log, "\n[%02u] ", i / 8);
+				}
+				else
+				{
+					to_log += ", ";
+				}
+
+				fmt::append(to_log, "0x%05x", sec.funcs[i]);
+			}
+
+			spu_log.notice("Found SPU function(s) at:%s", to_log);
+		}
 	}
 
-	spu_log.success("Found %u SPU function(s)", obj.funcs.size());
+	spu_log.success("Found %u SPU function(s) in %u segment(s) (%u segment(s) from discovery cache)", total_funcs, data_list.size(), data_list.size() - pending.size());
 
-	g_fxo->get<spu_cache>().precompile_funcs.push(std::move(obj));
+	// Nothing to add for these
+	std::erase_if(data_list, [](const spu_cache::precompile_data_t& sec) { return sec.funcs.empty(); });
 }
 
 // For SPU cache validity check
@@ -752,22 +863,37 @@ void spu_cache::initialize(bool build_existing_cache)
 	atomic_t<usz> fnext{};
 	atomic_t<u8> fail_flag{0};
 
-	auto data_list = g_fxo->get<spu_cache>().precompile_funcs.pop_all();
+	std::vector<precompile_data_t> data_list;
+	{
+		std::unordered_set<u64> known_hashes;
+
+		for (auto&& sec : g_fxo->get<spu_cache>().precompile_funcs.pop_all())
+		{
+			// Merge identical segments
+			if (known_hashes.emplace(sec.hash).second)
+			{
+				data_list.emplace_back(std::move(sec));
+			}
+		}
+	}
+
 	g_fxo->get<spu_cache>().collect_funcs_to_precompile = false;
 
 	usz total_precompile = 0;
 
-	for (auto& sec : data_list)
-	{
-		total_precompile += sec.funcs.size();
-	}
-
 	const bool spu_precompilation_enabled = func_list.empty() && g_cfg.core.spu_cache && g_cfg.core.llvm_precompilation;
 
 	if (spu_precompilation_enabled)
 	{
 		// What compiles in this case goes straight to disk
 		g_fxo->get<spu_cache>() = std::move(cache);
+
+		discover_spu_precompile_funcs(data_list, ppu_cache);
+
+		for (auto& sec : data_list)
+		{
+			total_precompile += sec.funcs.size();
+		}
 	}
 	else if (!build_existing_cache)
 	{
@@ -775,7 +901,6 @@ void spu_cache::initialize(bool build_existing_cache)
 	}
 	else
 	{
-		total_precompile = 0;
 		data_list = {};
 	}
 
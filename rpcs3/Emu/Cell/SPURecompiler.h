@@ -42,6 +42,9 @@ public:
 		u32 vaddr;
 		std::vector<u32> inst_data;
 		std::vector<u32> funcs;
+
+		// Content hash of the segment (including its address), used to merge duplicates and cache discovery results
+		u64 hash;
 	};
 
 	bool collect_funcs_to_precompile = true;
@@ -3521,6 +3521,12 @@ bool spu_thread::do_list_transfer(spu_mfc_cmd& args)
 			const u8* src = vm::_ptr<u8>(addr);
 			u8* dst = this->ls + arg_lsa + (addr & 0xf);
 
+			if (index + 1 < fetch_size)
+			{
+				// Source of the next element (may be outside of the list, prefetch is harmless)
+				utils::prefetch_read(vm::_ptr<u8>(items[index + 1].ea));
+			}
+
 			switch (u32 _size = size)
 			{
 			case 1:
@@ -3589,13 +3595,34 @@ bool spu_thread::do_list_transfer(spu_mfc_cmd& args)
 		// Avoid inlining huge transfers because it intentionally drops range lock unlock
 		else if (optimization_compatible == MFC_PUT_CMD && ((addr >> 28 == rsx::constants::local_mem_base >> 28) || (addr < RAW_SPU_BASE_ADDR && size - 1 <= 0x400 - 1 && (addr % 0x10000 + (size - 1)) < 0x10000)))
 		{
+			// Amount of following elements merged into this transfer
+			u32 merged = 0;
+			u32 span_size = size;
+
+			if (addr < RAW_SPU_BASE_ADDR && addr % 16 == 0 && size % 16 == 0)
+			{
+				// Coalesce contiguous elements (both in LS and EA) so the range is locked only once
+				// Only fetched elements which are part of the list are considered, stalls end the span
+				for (u32 next = index + 1; next < fetch_size && arg_size > 8 * (merged + 1) && !(items[next - 1].sb & 0x80); next++, merged++)
+				{
+					const u32 size2 = items[next].ts & ts_mask;
+
+					if (items[next].ea != addr + span_size || !size2 || size2 % 16 || span_size + size2 > 0x400 || addr % 0x10000 + (span_size + size2 - 1) >= 0x10000)
+					{
+						break;
+					}
+
+					span_size += size2;
+				}
+			}
+
 			if (addr >> 28 != rsx::constants::local_mem_base >> 28)
 			{
-				rsx_lock.update_if_enabled(addr, size, range_lock);
+				rsx_lock.update_if_enabled(addr, span_size, range_lock);
 
 				if (!g_use_rtm)
 				{
-					vm::range_lock(range_lock, addr & -128, utils::align<u32>(addr + size, 128) - (addr & -128));
+					vm::range_lock(range_lock, addr & -128, utils::align<u32>(addr + span_size, 128) - (addr & -128));
 				}
 			}
 			else
@@ -3607,7 +3634,7 @@ bool spu_thread::do_list_transfer(spu_mfc_cmd& args)
 			u8* dst = vm::_ptr<u8>(addr);
 			const u8* src = this->ls + arg_lsa + (addr & 0xf);
 
-			switch (u32 _size = size)
+			switch (u32 _size = span_size)
 			{
 			case 1:
 			{
@@ -3670,7 +3697,12 @@ bool spu_thread::do_list_transfer(spu_mfc_cmd& args)
 			}
 			}
 
-			arg_lsa += utils::align<u32>(size, 16);
+			arg_lsa += utils::align<u32>(span_size, 16);
+
+			// Skip merged elements
+			arg_size -= 8 * merged;
+			item_ptr += merged;
+			index += merged;
 		}
 		else if (size)
 		{
@@ -1293,8 +1293,494 @@ thread_local DECLARE(lv2_obj::g_to_notify){};
 thread_local DECLARE(lv2_obj::g_postpone_notify_barrier){};
 thread_local DECLARE(lv2_obj::g_to_awake);
 
+// Hierarchical timer wheel for lv2 timeouts (guest time in microseconds)
+// Insertion and cancellation are O(1), expired entries are collected in batches
+class lv2_timeout_wheel
+{
+	static constexpr u32 c_slot_bits = 6;
+	static constexpr u32 c_slots = 1u << c_slot_bits;
+	static constexpr u32 c_levels = 4;
+
+	// Buckets beyond the wheel levels: far future entries and entries already expired on insertion
+	static constexpr u32 c_overflow = c_levels * c_slots;
+	static constexpr u32 c_due = c_overflow + 1;
+
+	struct entry_t
+	{
+		u64 deadline;
+		cpu_thread* cpu;
+	};
+
+	struct location_t
+	{
+		u32 bucket;
+		u32 index;
+	};
+
+	std::vector<entry_t> m_buckets[c_due + 1]{};
+
+	// Occupied slots per level
+	u64 m_mask[c_levels]{};
+
+	// Every entry in the wheel has a deadline at or after this point
+	u64 m_time = 0;
+
+	std::unordered_map<cpu_thread*, location_t> m_locations;
+
+	// Lateness of expirations (log2 buckets of microseconds)
+	std::array<u64, 24> m_lateness{};
+
+	void place(const entry_t& entry)
+	{
+		u32 bucket = c_due;
+
+		if (entry.deadline >= m_time)
+		{
+			bucket = c_overflow;
+
+			for (u32 level = 0, shift = 0; level < c_levels; level++, shift += c_slot_bits)
+			{
+				// Use the lowest level on which the deadline shares the parent slot with the current time
+				if ((entry.deadline >> (shift + c_slot_bits)) == (m_time >> (shift + c_slot_bits)))
+				{
+					const u32 slot = (entry.deadline >> shift) % c_slots;
+					m_mask[level] |= u64{1} << slot;
+					bucket = level * c_slots + slot;
+					break;
+				}
+			}
+		}
+
+		auto& list = m_buckets[bucket];
+		m_locations[entry.cpu] = {bucket, ::size32(list)};
+		list.emplace_back(entry);
+	}
+
+	void erase(location_t loc)
+	{
+		auto& list = m_buckets[loc.bucket];
+
+		if (loc.index + 1 != list.size())
+		{
+			list[loc.index] = list.back();
+			m_locations[list[loc.index].cpu].index = loc.index;
+		}
+
+		list.pop_back();
+
+		if (list.empty() && loc.bucket < c_overflow)
+		{
+			m_mask[loc.bucket / c_slots] &= ~(u64{1} << (loc.bucket % c_slots));
+		}
+	}
+
+	// Move entries of the bucket to lower levels
+	void redistribute(u32 bucket)
+	{
+		std::vector<entry_t> list = std::move(m_buckets[bucket]);
+		m_buckets[bucket].clear();
+
+		if (bucket < c_overflow)
+		{
+			m_mask[bucket / c_slots] &= ~(u64{1} << (bucket % c_slots));
+		}
+
+		for (const entry_t& entry : list)
+		{
+			place(entry);
+		}
+	}
+
+	// Called when m_time reaches a slot boundary of a higher level
+	void cascade()
+	{
+		if (m_time % (u64{1} << (c_slot_bits * c_levels)) == 0 && !m_buckets[c_overflow].empty())
+		{
+			redistribute(c_overflow);
+		}
+
+		for (u32 level = c_levels - 1, shift = c_slot_bits * level; level; level--, shift -= c_slot_bits)
+		{
+			if (m_time % (u64{1} << shift) == 0)
+			{
+				if (const u32 slot = (m_time >> shift) % c_slots; m_mask[level] & (u64{1} << slot))
+				{
+					redistribute(level * c_slots + slot);
+				}
+			}
+		}
+	}
+
+	template <typename F>
+	void expire(u32 bucket, u64 current_time, F&& func)
+	{
+		std::vector<entry_t> list = std::move(m_buckets[bucket]);
+		m_buckets[bucket].clear();
+
+		if (bucket < c_overflow)
+		{
+			m_mask[bucket / c_slots] &= ~(u64{1} << (bucket % c_slots));
+		}
+
+		for (const entry_t& entry : list)
+		{
+			m_locations.erase(entry.cpu);
+
+			const u64 lateness = current_time - std::min(entry.deadline, current_time);
+			m_lateness[std::min<usz>(lateness ? std::bit_width(lateness) : 0, m_lateness.size() - 1)]++;
+
+			func(entry.cpu);
+		}
+	}
+
+public:
+	bool empty() const
+	{
+		return m_locations.empty();
+	}
+
+	// Register the timeout of the thread (replaces the previous one)
+	void insert(cpu_thread* cpu, u64 deadline, u64 current_time)
+	{
+		if (auto found = m_locations.find(cpu); found != m_locations.end())
+		{
+			erase(found->second);
+			m_locations.erase(found);
+		}
+
+		if (m_locations.empty())
+		{
+			// The wheel can be freely rebased when empty
+			m_time = current_time;
+		}
+
+		place({deadline, cpu});
+	}
+
+	// Unregister the timeout of the thread
+	bool remove(cpu_thread* cpu)
+	{
+		if (auto found = m_locations.find(cpu); found != m_locations.end())
+		{
+			erase(found->second);
+			m_locations.erase(found);
+			return true;
+		}
+
+		return false;
+	}
+
+	// Call func for every thread which timeout is at or before current_time
+	template <typename F>
+	void advance(u64 current_time, F&& func)
+	{
+		if (!m_buckets[c_due].empty())
+		{
+			expire(c_due, current_time, func);
+		}
+
+		// Exclusive bound
+		const u64 target = current_time + 1;
+
+		while (m_time < target)
+		{
+			if (m_locations.empty())
+			{
+				m_time = target;
+				break;
+			}
+
+			if (const u64 bits = m_mask[0] >> (m_time % c_slots))
+			{
+				const u64 time = m_time + std::countr_zero(bits);
+
+				if (time >= target)
+				{
+					m_time = target;
+					break;
+				}
+
+				expire(static_cast<u32>(time % c_slots), current_time, func);
+				m_time = time + 1;
+
+				if (m_time % c_slots == 0)
+				{
+					cascade();
+				}
+
+				continue;
+			}
+
+			// Find the next occupied slot of higher levels
+			u64 next = umax;
+
+			for (u32 level = 1, shift = c_slot_bits; level < c_levels; level++, shift += c_slot_bits)
+			{
+				const u32 slot = (m_time >> shift) % c_slots;
+
+				if (const u64 bits = m_mask[level] & ~((u64{2} << slot) - 1))
+				{
+					next = ((m_time >> (shift + c_slot_bits)) << (shift + c_slot_bits)) + (u64{static_cast<u32>(std::countr_zero(bits))} << shift);
+					break;
+				}
+			}
+
+			if (next == umax)
+			{
+				// Only far future entries are left
+				constexpr u32 shift = c_slot_bits * c_levels;
+				next = ((m_time >> shift) + 1) << shift;
+			}
+
+			if (next > target)
+			{
+				m_time = target;
+				break;
+			}
+
+			m_time = next;
+			cascade();
+		}
+	}
+
+	void clear()
+	{
+		for (auto& list : m_buckets)
+		{
+			list.clear();
+		}
+
+		std::fill(std::begin(m_mask), std::end(m_mask), 0);
+		m_locations.clear();
+		m_time = 0;
+	}
+
+	// Get lateness statistics and reset them
+	std::array<u64, 24> take_lateness()
+	{
+		return std::exchange(m_lateness, {});
+	}
+};
+
 // Scheduler queue for timeouts (wait until -> thread)
-static std::deque<std::pair<u64, class cpu_thread*>> g_waiting;
+static lv2_timeout_wheel g_waiting;
+
+// Per-priority index of the ready queue (lv2_obj::g_ppu) for thread_scheduler_mode::os_lv2_queues
+// Threads of the same priority form a FIFO group of consecutive nodes in the chain, non-empty groups are tracked in a two-level bitmap
+// Insertion and removal cost O(threads of the same priority) instead of a walk over the whole chain
+class lv2_ready_index
+{
+	// Covers the whole 13-bit signed priority field
+	static constexpr u32 c_prio_count = 8192;
+	static constexpr s32 c_prio_base = 4096;
+
+	ppu_thread* m_head[c_prio_count]{};
+	ppu_thread* m_tail[c_prio_count]{};
+	u32 m_count[c_prio_count]{};
+
+	u64 m_bits[c_prio_count / 64]{};
+	u64 m_summary[c_prio_count / 64 / 64]{};
+
+	static u32 index_of(const ppu_thread* ppu)
+	{
+		return static_cast<u32>(ppu->prio.load().prio + c_prio_base);
+	}
+
+	void set_bit(u32 index)
+	{
+		m_bits[index / 64] |= u64{1} << (index % 64);
+		m_summary[index / 4096] |= u64{1} << (index / 64 % 64);
+	}
+
+	void clear_bit(u32 index)
+	{
+		if (!(m_bits[index / 64] &= ~(u64{1} << (index % 64))))
+		{
+			m_summary[index / 4096] &= ~(u64{1} << (index / 64 % 64));
+		}
+	}
+
+	// Find the last non-empty group at or before index (umax if none)
+	u32 find_at_or_before(u32 index) const
+	{
+		if (index >= c_prio_count)
+		{
+			return umax;
+		}
+
+		const u32 word = index / 64;
+
+		if (const u64 bits = m_bits[word] & (~u64{0} >> (63 - index % 64)))
+		{
+			return word * 64 + 63 - std::countl_zero(bits);
+		}
+
+		// Look for the words before it
+		for (u32 i = word / 64 + 1; i--;)
+		{
+			u64 summary = m_summary[i];
+
+			if (i == word / 64)
+			{
+				summary &= (u64{1} << (word % 64)) - 1;
+			}
+
+			if (summary)
+			{
+				const u32 found = i * 64 + 63 - std::countl_zero(summary);
+				return found * 64 + 63 - std::countl_zero(m_bits[found]);
+			}
+		}
+
+		return umax;
+	}
+
+	// Find the predecessor of the thread in the chain (nullptr if it is the first one)
+	bool find(const ppu_thread* ppu, ppu_thread*& prev) const
+	{
+		const u32 index = index_of(ppu);
+
+		if (!m_count[index])
+		{
+			return false;
+		}
+
+		if (m_head[index] == ppu)
+		{
+			const u32 before = find_at_or_before(index - 1);
+			prev = before == umax ? nullptr : m_tail[before];
+			return true;
+		}
+
+		for (ppu_thread* it = m_head[index]; it != m_tail[index]; it = it->next_ppu)
+		{
+			if (it->next_ppu == ppu)
+			{
+				prev = it;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+public:
+	// Link the thread at the end (or the beginning) of its priority group, returns false if already queued
+	bool insert(ppu_thread*& first, ppu_thread* ppu, bool push_first)
+	{
+		if (ppu_thread* prev{}; find(ppu, prev))
+		{
+			return false;
+		}
+
+		const u32 index = index_of(ppu);
+		const u32 before = find_at_or_before(push_first ? index - 1 : index);
+		ppu_thread*& link = before == umax ? first : m_tail[before]->next_ppu;
+
+		atomic_storage<ppu_thread*>::release(ppu->next_ppu, +link);
+		atomic_storage<ppu_thread*>::release(link, ppu);
+
+		if (!m_count[index]++)
+		{
+			m_head[index] = ppu;
+			m_tail[index] = ppu;
+			set_bit(index);
+		}
+		else if (push_first)
+		{
+			m_head[index] = ppu;
+		}
+		else
+		{
+			m_tail[index] = ppu;
+		}
+
+		return true;
+	}
+
+	// Unlink the thread, returns false if not queued
+	bool remove(ppu_thread*& first, ppu_thread* ppu)
+	{
+		ppu_thread* prev{};
+
+		if (!find(ppu, prev))
+		{
+			return false;
+		}
+
+		const u32 index = index_of(ppu);
+		ppu_thread* const next = ppu->next_ppu;
+
+		atomic_storage<ppu_thread*>::release(prev ? prev->next_ppu : first, next);
+		atomic_storage<ppu_thread*>::release(ppu->next_ppu, nullptr);
+
+		if (!--m_count[index])
+		{
+			m_head[index] = nullptr;
+			m_tail[index] = nullptr;
+			clear_bit(index);
+		}
+		else if (m_head[index] == ppu)
+		{
+			m_head[index] = next;
+		}
+		else if (m_tail[index] == ppu)
+		{
+			m_tail[index] = prev;
+		}
+
+		return true;
+	}
+
+	// Move the thread behind the other threads of its priority, returns its new position in the chain
+	// Returns umax if the thread is not queued or there was nothing to rotate
+	usz rotate(ppu_thread*& first, ppu_thread* ppu)
+	{
+		const u32 index = index_of(ppu);
+
+		if (m_tail[index] == ppu || !remove(first, ppu))
+		{
+			return umax;
+		}
+
+		insert(first, ppu, false);
+
+		usz pos = m_count[index] - 1;
+
+		for (u32 word = 0; word <= index / 64; word++)
+		{
+			u64 bits = m_bits[word];
+
+			if (word == index / 64)
+			{
+				bits &= (u64{1} << (index % 64)) - 1;
+			}
+
+			for (; bits; bits &= bits - 1)
+			{
+				pos += m_count[word * 64 + std::countr_zero(bits)];
+			}
+		}
+
+		return pos;
+	}
+
+	void clear()
+	{
+		std::fill(std::begin(m_head), std::end(m_head), nullptr);
+		std::fill(std::begin(m_tail), std::end(m_tail), nullptr);
+		std::fill(std::begin(m_count), std::end(m_count), 0);
+		std::fill(std::begin(m_bits), std::end(m_bits), 0);
+		std::fill(std::begin(m_summary), std::end(m_summary), 0);
+	}
+};
+
+static lv2_ready_index g_ready;
+
+static bool use_ready_index()
+{
+	return g_cfg.core.thread_scheduler == thread_scheduler_mode::os_lv2_queues;
+}
 
 // Threads which must call lv2_obj::sleep before the scheduler starts
 static std::deque<class cpu_thread*> g_to_sleep;
@@ -1304,6 +1790,22 @@ static atomic_t<u64> s_max_allowed_yield_tsc = 0;
 static u64 s_last_yield_tsc = 0;
 atomic_t<u32> g_lv2_preempts_taken = 0;
 
+// Amount of times lv2_obj::g_mutex was found already locked (only the slow path is counted)
+static atomic_t<u64> s_scheduler_contention = 0;
+
+void lv2_obj::count_scheduler_contention() noexcept
+{
+	s_scheduler_contention++;
+}
+
+// Lateness of sys_timer expirations, which are not kept in g_waiting (log2 buckets of microseconds)
+static std::array<atomic_t<u64>, 24> s_timer_lateness{};
+
+void lv2_obj::record_timer_lateness(u64 lateness) noexcept
+{
+	s_timer_lateness[std::min<usz>(lateness ? std::bit_width(lateness) : 0, s_timer_lateness.size() - 1)]++;
+}
+
 namespace cpu_counter
 {
 	void remove(cpu_thread*) noexcept;
@@ -1359,7 +1861,7 @@ bool lv2_obj::sleep(cpu_thread& cpu, const u64 timeout)
 	bool result = false;
 	const u64 current_time = get_guest_system_time();
 	{
-		std::lock_guard lock{g_mutex};
+		lv2_scheduler_lock lock;
 		result = sleep_unlocked(cpu, timeout, current_time);
 
 		if (!g_to_awake.empty())
@@ -1411,7 +1913,7 @@ bool lv2_obj::awake(cpu_thread* thread, s32 prio)
 
 	bool result = false;
 	{
-		std::lock_guard lock(g_mutex);
+		lv2_scheduler_lock lock;
 		result = awake_unlocked(thread, prio);
 		schedule_all();
 	}
@@ -1527,7 +2029,7 @@ bool lv2_obj::sleep_unlocked(cpu_thread& thread, u64 timeout, u64 current_time)
 		}
 
 		// Find and remove the thread
-		if (!unqueue(g_ppu, ppu, &ppu_thread::next_ppu))
+		if (use_ready_index() ? !g_ready.remove(g_ppu, ppu) : !unqueue(g_ppu, ppu, &ppu_thread::next_ppu))
 		{
 			if (auto it = std::find(g_to_sleep.begin(), g_to_sleep.end(), ppu); it != g_to_sleep.end())
 			{
@@ -1563,14 +2065,7 @@ bool lv2_obj::sleep_unlocked(cpu_thread& thread, u64 timeout, u64 current_time)
 		const u64 wait_until = start_time + std::min<u64>(timeout, ~start_time);
 
 		// Register timeout if necessary
-		for (auto it = g_waiting.cbegin(), end = g_waiting.cend();; it++)
-		{
-			if (it == end || it->first > wait_until)
-			{
-				g_waiting.emplace(it, wait_until, &thread);
-				break;
-			}
-		}
+		g_waiting.insert(&thread, wait_until, start_time);
 	}
 
 	return return_val;
@@ -1621,7 +2116,7 @@ bool lv2_obj::awake_unlocked(cpu_thread* cpu, s32 prio)
 			return true;
 		}
 
-		if (!unqueue(g_ppu, static_cast<ppu_thread*>(cpu), &ppu_thread::next_ppu))
+		if (use_ready_index() ? !g_ready.remove(g_ppu, static_cast<ppu_thread*>(cpu)) : !unqueue(g_ppu, static_cast<ppu_thread*>(cpu), &ppu_thread::next_ppu))
 		{
 			set_prio(static_cast<ppu_thread*>(cpu)->prio, prio, old_prio > prio, old_prio < prio);
 			return true;
@@ -1632,6 +2127,20 @@ bool lv2_obj::awake_unlocked(cpu_thread* cpu, s32 prio)
 	}
 	case yield_cmd:
 	{
+		if (use_ready_index())
+		{
+			const usz pos = g_ready.rotate(g_ppu, static_cast<ppu_thread*>(cpu));
+
+			if (pos == umax || pos < g_cfg.core.ppu_threads + 0u)
+			{
+				// Empty 'same prio' threads list, or threads were rotated but no context switch was made
+				return false;
+			}
+
+			static_cast<ppu_thread*>(cpu)->start_time = get_guest_system_time();
+			break;
+		}
+
 		usz i = 0;
 
 		// Yield command
@@ -1693,21 +2202,20 @@ bool lv2_obj::awake_unlocked(cpu_thread* cpu, s32 prio)
 
 	const auto emplace_thread = [push_first](cpu_thread* const cpu)
 	{
-		for (auto it = &g_ppu;;)
+		bool queued = false;
+
+		if (use_ready_index())
+		{
+			queued = !g_ready.insert(g_ppu, static_cast<ppu_thread*>(cpu), push_first);
+		}
+		else for (auto it = &g_ppu;;)
 		{
 			const auto next = +*it;
 
 			if (next == cpu)
 			{
-				ppu_log.trace("sleep() - suspended (p=%zu)", g_pending);
-
-				if (static_cast<ppu_thread*>(cpu)->cancel_sleep == 1)
-				{
-					// The next sleep call of the thread is cancelled
-					static_cast<ppu_thread*>(cpu)->cancel_sleep = 2;
-				}
-
-				return false;
+				queued = true;
+				break;
 			}
 
 			// Use priority, also preserve FIFO order
@@ -1721,16 +2229,22 @@ bool lv2_obj::awake_unlocked(cpu_thread* cpu, s32 prio)
 			it = &next->next_ppu;
 		}
 
-		// Unregister timeout if necessary
-		for (auto it = g_waiting.cbegin(), end = g_waiting.cend(); it != end; it++)
+		if (queued)
 		{
-			if (it->second == cpu)
+			ppu_log.trace("sleep() - suspended (p=%zu)", g_pending);
+
+			if (static_cast<ppu_thread*>(cpu)->cancel_sleep == 1)
 			{
-				g_waiting.erase(it);
-				break;
+				// The next sleep call of the thread is cancelled
+				static_cast<ppu_thread*>(cpu)->cancel_sleep = 2;
 			}
+
+			return false;
 		}
 
+		// Unregister timeout if necessary
+		g_waiting.remove(cpu);
+
 		ppu_log.trace("awake(): %s", cpu->id);
 		return true;
 	};
@@ -1823,7 +2337,43 @@ bool lv2_obj::awake_unlocked(cpu_thread* cpu, s32 prio)
 
 void lv2_obj::cleanup()
 {
+	if (const u64 contention = s_scheduler_contention.exchange(0))
+	{
+		ppu_log.notice("LV2 scheduler (%s): lock was contended %u times", g_cfg.core.thread_scheduler.get(), contention);
+	}
+
+	auto print_lateness = [](std::string_view what, const auto& buckets)
+	{
+		std::string lateness;
+
+		for (usz i = 0; i < buckets.size(); i++)
+		{
+			if (const u64 count = buckets[i])
+			{
+				fmt::append(lateness, " <%uus: %u,", u64{1} << i, count);
+			}
+		}
+
+		if (!lateness.empty())
+		{
+			lateness.pop_back();
+			ppu_log.notice("%s lateness:%s", what, lateness);
+		}
+	};
+
+	print_lateness("LV2 timeouts", g_waiting.take_lateness());
+
+	std::array<u64, 24> timer_lateness{};
+
+	for (usz i = 0; i < timer_lateness.size(); i++)
+	{
+		timer_lateness[i] = s_timer_lateness[i].exchange(0);
+	}
+
+	print_lateness("LV2 sys_timer", timer_lateness);
+
 	g_ppu = nullptr;
+	g_ready.clear();
 	g_scheduler_ready = false;
 	g_to_sleep.clear();
 	g_waiting.clear();
@@ -1870,42 +2420,34 @@ void lv2_obj::schedule_all(u64 current_time)
 	}
 
 	// Check registered timeouts
-	while (!g_waiting.empty())
+	if (!g_waiting.empty())
 	{
-		const auto pair = &g_waiting.front();
-
 		if (!current_time)
 		{
 			current_time = get_guest_system_time();
 		}
 
-		if (pair->first <= current_time)
+		g_waiting.advance(current_time, [&](cpu_thread* target)
 		{
-			const auto target = pair->second;
-			g_waiting.pop_front();
-
-			if (target != cpu_thread::get_current())
+			if (target == cpu_thread::get_current())
 			{
-				// Change cpu_thread::state for the lightweight notification to work
-				ensure(!target->state.test_and_set(cpu_flag::notify));
+				return;
+			}
 
-				// Otherwise notify it to wake itself
-				if (it == std::end(g_to_notify))
-				{
-					// Out of notification slots, notify locally (resizable container is not worth it)
-					target->state.notify_one();
-				}
-				else
-				{
-					*it++ = &target->state;
-				}
+			// Change cpu_thread::state for the lightweight notification to work
+			ensure(!target->state.test_and_set(cpu_flag::notify));
+
+			// Otherwise notify it to wake itself
+			if (it == std::end(g_to_notify))
+			{
+				// Out of notification slots, notify locally (resizable container is not worth it)
+				target->state.notify_one();
 			}
-		}
-		else
-		{
-			// The list is sorted so assume no more timeouts
-			break;
-		}
+			else
+			{
+				*it++ = &target->state;
+			}
+		});
 	}
 
 	if (it < std::end(g_to_notify))
@@ -1968,11 +2510,12 @@ void lv2_obj::make_scheduler_ready()
 
 std::pair<ppu_thread_status, u32> lv2_obj::ppu_state(ppu_thread* ppu, bool lock_idm, bool lock_lv2)
 {
-	std::optional<reader_lock> opt_lock[2];
+	std::optional<reader_lock> idm_lock;
+	std::optional<lv2_scheduler_lock<true>> lv2_lock;
 
 	if (lock_idm)
 	{
-		opt_lock[0].emplace(id_manager::g_mutex);
+		idm_lock.emplace(id_manager::g_mutex);
 	}
 
 	if (!Emu.IsReady() ? ppu->state.all_of(cpu_flag::stop) : ppu->stop_flag_removal_protection)
@@ -1989,7 +2532,7 @@ std::pair<ppu_thread_status, u32> lv2_obj::ppu_state(ppu_thread* ppu, bool lock_
 
 	if (lock_lv2)
 	{
-		opt_lock[1].emplace(lv2_obj::g_mutex);
+		lv2_lock.emplace();
 	}
 
 	u32 pos = umax;
@@ -2029,7 +2572,7 @@ void lv2_obj::set_future_sleep(cpu_thread* cpu)
 
 bool lv2_obj::is_scheduler_ready()
 {
-	reader_lock lock(g_mutex);
+	lv2_scheduler_lock<true> lock;
 	return g_to_sleep.empty();
 }
 
@@ -13,8 +13,15 @@
 #include "Emu/IdManager.h"
 #include "Emu/system_utils.hpp"
 #include "Emu/Cell/lv2/sys_process.h"
+#include "Emu/Cell/lv2/sys_event.h"
+#include "Utilities/lockless.h"
+#include "util/sysinfo.hpp"
 
+#include <array>
 #include <filesystem>
+#include <list>
+#include <map>
+#include <set>
 #include <span>
 #include <shared_mutex>
 
@@ -382,6 +389,12 @@ lv2_fs_object::lv2_fs_object(utils::serial& ar, bool)
 
 u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size, u64 opt_pos)
 {
+	if (file.get_mapping())
+	{
+		// Reading memory-mapped file is a plain memcpy, copy directly to destination
+		return (opt_pos == umax ? file.read(buf.get_ptr(), size) : file.read_at(opt_pos, buf.get_ptr(), size));
+	}
+
 	if (u64 region = buf.addr() >> 28, region_end = (buf.addr() & 0xfff'ffff) + (size & 0xfff'ffff); region == region_end && ((region >> 28) == 0 || region >= 0xC))
 	{
 		// Optimize reads from safe memory
@@ -410,6 +423,363 @@ u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size, u64 opt
 	return result;
 }
 
+// Host latency and concurrency of guest reads
+struct lv2_fs_read_stats
+{
+	atomic_t<u64> count = 0;
+	atomic_t<u32> depth = 0;
+	atomic_t<u32> max_depth = 0;
+	atomic_t<u64> total_us = 0;
+	atomic_t<u64> max_us = 0;
+
+	template <typename F>
+	u64 measure(F&& read)
+	{
+		const u32 cur_depth = ++depth;
+		max_depth.atomic_op([&](u32& v) { v = std::max(v, cur_depth); });
+
+		const u64 start = get_system_time();
+		const u64 result = read();
+		const u64 elapsed = get_system_time() - start;
+
+		depth--;
+		count++;
+		total_us += elapsed;
+		max_us.atomic_op([&](u64& v) { v = std::max(v, elapsed); });
+		return result;
+	}
+
+	~lv2_fs_read_stats()
+	{
+		if (const u64 reads = count)
+		{
+			sys_fs.notice("File reads: %u, average latency: %uus, max latency: %uus, max concurrent: %u", reads, total_us / reads, max_us.load(), max_depth.load());
+		}
+	}
+};
+
+// Read-ahead of fixed size blocks for files read sequentially by the guest
+struct lv2_fs_readahead
+{
+	static constexpr u64 block_size = 0x40000;
+	static constexpr u64 window = 4; // Blocks prefetched beyond the position of a sequential reader
+
+	struct block
+	{
+		std::vector<u8> data; // Shorter than block_size at the end of file
+		u64 gen = 0;
+	};
+
+	struct request
+	{
+		shared_ptr<lv2_file> file;
+		u64 id;
+		u64 index;
+		u64 gen;
+	};
+
+	using key_t = std::pair<u64, u64>; // File read-ahead ID, block index
+
+	struct host_file
+	{
+		u64 gen = 0; // Renewed by every write or truncation of the host file, invalidates its blocks
+		u64 refs = 0; // Open files using read-ahead
+	};
+
+	shared_mutex mutex;
+	std::map<key_t, std::pair<std::shared_ptr<const block>, std::list<key_t>::iterator>> blocks;
+	std::list<key_t> lru; // Most recently used first
+	std::set<key_t> pending;
+	std::map<std::string, host_file> host_files; // Keyed by fs::file_id
+	usz memory_used = 0;
+	u64 next_id = 0;
+	u64 next_gen = 0;
+
+	lf_queue<request> queue;
+
+	atomic_t<u64> tracked = 0; // Size of host_files, checked by writers without locking
+
+	atomic_t<u64> hits = 0;
+	atomic_t<u64> misses = 0;
+	atomic_t<u64> prefetched = 0;
+
+	static u64 budget()
+	{
+		return g_cfg.core.fs_readahead_cache_size * u64{1024 * 1024};
+	}
+
+	static bool is_eligible(const lv2_file& file, u64 size)
+	{
+		// Files on read-only mounts larger than the threshold are memory mapped instead
+		return file.type == lv2_file_type::regular && !(file.flags & CELL_FS_O_ACCMODE) && !file.file.get_mapping() && size <= block_size * window && budget();
+	}
+
+	static std::string get_key(const fs::file& file)
+	{
+		const fs::file_id id = file.get_id();
+
+		std::string key = id.type;
+		key.append(id.data.begin(), id.data.end());
+		return key;
+	}
+
+	// Current generation of the host file (called with mutex locked)
+	u64 get_gen(const std::string& key) const
+	{
+		const auto found = host_files.find(key);
+		return found != host_files.end() ? found->second.gen : 0;
+	}
+
+	// Copy [pos, pos + size) to dst if it is entirely cached (file position is not changed)
+	bool read(const lv2_file& file, u64 pos, u8* dst, u64 size)
+	{
+		if (!size)
+		{
+			return false;
+		}
+
+		std::shared_ptr<const block> found[window + 1];
+
+		const u64 first = pos / block_size;
+		const u64 last = (pos + size - 1) / block_size;
+
+		{
+			std::lock_guard lock(mutex);
+
+			if (!file.ra_id)
+			{
+				return false;
+			}
+
+			const u64 cur_gen = get_gen(file.ra_key);
+
+			for (u64 i = first; i <= last; i++)
+			{
+				const auto it = blocks.find(key_t{file.ra_id, i});
+
+				if (it == blocks.end() || it->second.first->gen != cur_gen)
+				{
+					misses++;
+					return false;
+				}
+
+				lru.splice(lru.begin(), lru, it->second.second);
+				found[i - first] = it->second.first;
+			}
+		}
+
+		for (u64 i = first, done = 0; i <= last; i++)
+		{
+			const auto& data = found[i - first]->data;
+			const u64 offset = (pos + done) % block_size;
+			const u64 count = std::min<u64>(size - done, block_size - offset);
+
+			if (offset + count > data.size())
+			{
+				// Reading past the end of file is left to the regular path
+				misses++;
+				return false;
+			}
+
+			std::memcpy(dst + done, data.data() + offset, count);
+			done += count;
+		}
+
+		hits++;
+		return true;
+	}
+
+	// Detect sequential reading and schedule the following blocks
+	void access(const shared_ptr<lv2_file>& file, u64 pos, u64 size)
+	{
+		std::lock_guard lock(mutex);
+
+		file->ra_streak = pos == file->ra_next ? file->ra_streak + 1 : 0;
+		file->ra_next = pos + size;
+
+		if (file->ra_streak < 2 || !size)
+		{
+			return;
+		}
+
+		if (!file->ra_id)
+		{
+			file->ra_id = ++next_id;
+			file->ra_key = get_key(file->file);
+
+			if (auto& host = host_files[file->ra_key]; !host.refs++)
+			{
+				host.gen = ++next_gen;
+				tracked = host_files.size();
+			}
+		}
+
+		const u64 first = file->ra_next / block_size;
+		const u64 cur_gen = get_gen(file->ra_key);
+
+		for (u64 i = first; i < first + window; i++)
+		{
+			const key_t key{file->ra_id, i};
+
+			if (auto it = blocks.find(key); it != blocks.end() && it->second.first->gen == cur_gen)
+			{
+				continue;
+			}
+
+			if (pending.emplace(key).second)
+			{
+				queue.push(request{file, file->ra_id, i, cur_gen});
+			}
+		}
+	}
+
+	// Invalidate blocks of the host file after writing or truncating it
+	void invalidate(const fs::file& file)
+	{
+		if (!tracked)
+		{
+			return;
+		}
+
+		const std::string key = get_key(file);
+
+		std::lock_guard lock(mutex);
+
+		if (const auto found = host_files.find(key); found != host_files.end())
+		{
+			found->second.gen = ++next_gen;
+		}
+	}
+
+	void invalidate(const std::string& local_path)
+	{
+		if (!tracked)
+		{
+			return;
+		}
+
+		if (fs::file file{local_path})
+		{
+			invalidate(file);
+		}
+	}
+
+	// Drop blocks of a closed file
+	void forget(lv2_file& file)
+	{
+		std::lock_guard lock(mutex);
+
+		const u64 id = std::exchange(file.ra_id, 0);
+
+		if (!id)
+		{
+			return;
+		}
+
+		if (const auto found = host_files.find(file.ra_key); found != host_files.end() && !--found->second.refs)
+		{
+			host_files.erase(found);
+			tracked = host_files.size();
+		}
+
+		for (auto it = blocks.lower_bound(key_t{id, 0}); it != blocks.end() && it->first.first == id;)
+		{
+			memory_used -= it->second.first->data.size();
+			lru.erase(it->second.second);
+			it = blocks.erase(it);
+		}
+	}
+
+	// Check that the host file was not modified since the request was made
+	bool is_current(const request& req)
+	{
+		reader_lock lock(mutex);
+		return get_gen(req.file->ra_key) == req.gen;
+	}
+
+	void fill(const request& req)
+	{
+		const key_t key{req.id, req.index};
+
+		auto result = std::make_shared<block>();
+		result->gen = req.gen;
+		result->data.resize(block_size);
+
+		u64 nread = 0;
+
+		if (is_current(req))
+		{
+			std::shared_lock lock(req.file->mp->mutex);
+			std::shared_lock pos_lock(req.file->pos_mutex);
+
+			if (req.file->file)
+			{
+				nread = req.file->file.read_at(req.index * block_size, result->data.data(), block_size);
+			}
+		}
+
+		result->data.resize(nread);
+
+		std::lock_guard lock(mutex);
+
+		pending.erase(key);
+
+		const u64 limit = budget();
+
+		if (!nread || get_gen(req.file->ra_key) != req.gen || nread > limit)
+		{
+			return;
+		}
+
+		if (auto [found, inserted] = blocks.try_emplace(key); inserted)
+		{
+			lru.push_front(key);
+			found->second = {std::move(result), lru.begin()};
+		}
+		else
+		{
+			memory_used -= found->second.first->data.size();
+			lru.splice(lru.begin(), lru, found->second.second);
+			found->second.first = std::move(result);
+		}
+
+		memory_used += nread;
+		prefetched += nread;
+
+		// Evict least recently used blocks
+		while (memory_used > limit)
+		{
+			const auto old = blocks.find(lru.back());
+			memory_used -= old->second.first->data.size();
+			blocks.erase(old);
+			lru.pop_back();
+		}
+	}
+
+	void operator()()
+	{
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			for (auto&& req : queue.pop_all())
+			{
+				fill(req);
+			}
+
+			thread_ctrl::wait_on(queue);
+		}
+	}
+
+	~lv2_fs_readahead()
+	{
+		if (const u64 total = hits + misses)
+		{
+			sys_fs.notice("File read-ahead: %u hits of %u reads, %u bytes prefetched", hits.load(), total, prefetched.load());
+		}
+	}
+
+	static constexpr auto thread_name = "FS Read-Ahead Thread"sv;
+};
+
 u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 {
 	// Copy data to intermediate buffer (avoid passing vm pointer to a native API)
@@ -430,9 +800,223 @@ u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 		}
 	}
 
+	if (result)
+	{
+		g_fxo->get<named_thread<lv2_fs_readahead>>().invalidate(file);
+	}
+
 	return result;
 }
 
+// Asynchronous guest file I/O served by a pool of host threads (reads and writes go through the usual bounce buffers)
+struct lv2_fs_io_engine
+{
+	static constexpr u32 max_workers = 4;
+
+	struct request
+	{
+		shared_ptr<lv2_file> file;
+		shared_ptr<lv2_event_queue> queue;
+		vm::ptr<void> buf;
+		u64 offset;
+		u64 size;
+		u64 source;
+		u64 data1;
+		u64 submit_time;
+		bool write;
+	};
+
+	struct worker
+	{
+		lf_queue<request> queue;
+		atomic_t<u32> pending = 0;
+
+		void operator()()
+		{
+			while (thread_ctrl::state() != thread_state::aborting)
+			{
+				for (auto&& req : queue.pop_all())
+				{
+					g_fxo->get<lv2_fs_io_engine>().process(req);
+					pending--;
+				}
+
+				thread_ctrl::wait_on(queue);
+			}
+		}
+	};
+
+	shared_mutex mutex;
+	std::array<std::unique_ptr<named_thread<worker>>, max_workers> workers;
+	u32 worker_count = 0;
+
+	atomic_t<u64> count = 0;
+	atomic_t<u32> depth = 0;
+	atomic_t<u32> max_depth = 0;
+	atomic_t<u64> total_us = 0;
+	atomic_t<u64> max_us = 0;
+
+	void submit(request&& req)
+	{
+		std::lock_guard lock(mutex);
+
+		if (!worker_count)
+		{
+			// Started on first use
+			worker_count = std::clamp<u32>(utils::get_thread_count() / 2, 1, max_workers);
+
+			for (u32 i = 0; i < worker_count; i++)
+			{
+				workers[i] = std::make_unique<named_thread<worker>>(fmt::format("FS I/O Worker %u", i));
+			}
+		}
+
+		// Queue on the least busy worker
+		auto& target = **std::min_element(workers.begin(), workers.begin() + worker_count, [](const auto& a, const auto& b)
+		{
+			return a->pending < b->pending;
+		});
+
+		const u32 cur_depth = ++depth;
+		max_depth.atomic_op([&](u32& v) { v = std::max(v, cur_depth); });
+
+		target.pending++;
+		target.queue.push(std::move(req));
+	}
+
+	void process(const request& req)
+	{
+		const auto& file = req.file;
+
+		CellError error{};
+		u64 result = 0;
+
+		if (!req.write)
+		{
+			std::shared_lock lock(file->mp->mutex);
+			std::shared_lock pos_lock(file->pos_mutex);
+
+			if (!file->file)
+			{
+				error = CELL_EBADF;
+			}
+			else
+			{
+				auto& readahead = g_fxo->get<named_thread<lv2_fs_readahead>>();
+				const bool use_readahead = readahead.is_eligible(*file, req.size);
+
+				if (use_readahead && readahead.read(*file, req.offset, static_cast<u8*>(req.buf.get_ptr()), req.size))
+				{
+					result = req.size;
+				}
+				else
+				{
+					result = lv2_file::op_read(file->file, req.buf, req.size, req.offset);
+				}
+
+				if (use_readahead)
+				{
+					readahead.access(file, req.offset, result);
+				}
+			}
+		}
+		else
+		{
+			std::lock_guard lock(file->mp->mutex);
+
+			if (!file->file)
+			{
+				error = CELL_EBADF;
+			}
+			else
+			{
+				const u64 old_pos = file->file.pos();
+				file->file.seek(req.offset);
+				result = file->op_write(req.buf, req.size);
+				file->file.seek(old_pos);
+			}
+		}
+
+		const u64 elapsed = get_system_time() - req.submit_time;
+
+		depth--;
+		count++;
+		total_us += elapsed;
+		max_us.atomic_op([&](u64& v) { v = std::max(v, elapsed); });
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			lv2_obj::notify_all_t notify;
+
+			if (req.queue->send(req.source, req.data1, static_cast<u32>(error), result) != CELL_EBUSY)
+			{
+				break;
+			}
+
+			// Completion queue is full, wait for the guest handler to catch up
+			thread_ctrl::wait_for(100);
+		}
+	}
+
+	lv2_fs_io_engine& operator=(thread_state state) noexcept
+	{
+		std::lock_guard lock(mutex);
+
+		for (u32 i = 0; i < worker_count; i++)
+		{
+			*workers[i] = state;
+		}
+
+		return *this;
+	}
+
+	~lv2_fs_io_engine()
+	{
+		// Stop the workers before reporting
+		for (auto& thread : workers)
+		{
+			thread.reset();
+		}
+
+		if (const u64 requests = count)
+		{
+			sys_fs.notice("Asynchronous file I/O: %u requests, average latency: %uus, max latency: %uus, max queue depth: %u", requests, total_us / requests, max_us.load(), max_depth.load());
+		}
+	}
+};
+
+CellError lv2_file::submit_aio(shared_ptr<lv2_file> file, bool write, u64 offset, vm::ptr<void> buf, u64 size, shared_ptr<lv2_event_queue> queue, u64 source, u64 data1)
+{
+	if (!file || (write ? !(file->flags & CELL_FS_O_ACCMODE) : !!(file->flags & CELL_FS_O_WRONLY)))
+	{
+		return CELL_EBADF;
+	}
+
+	if (write && file->mp.read_only)
+	{
+		return CELL_EROFS;
+	}
+
+	if (file->type != lv2_file_type::regular)
+	{
+		return CELL_EINVAL;
+	}
+
+	// The workers have no guest thread to raise an access violation on
+	if (size && (size >> 32 || !vm::check_addr(buf.addr(), write ? vm::page_readable : vm::page_writable, static_cast<u32>(size))))
+	{
+		return CELL_EFAULT;
+	}
+
+	if (!queue)
+	{
+		return CELL_ESRCH;
+	}
+
+	g_fxo->get<lv2_fs_io_engine>().submit({std::move(file), std::move(queue), buf, offset, size, source, data1, get_system_time(), write});
+	return {};
+}
+
 lv2_file::lv2_file(utils::serial& ar)
 	: lv2_fs_object(ar, false)
 	, mode(ar)
@@ -901,6 +1485,17 @@ lv2_file::open_raw_result_t lv2_file::open_raw(const std::string& local_path, s3
 		return {CELL_ENOTMSELF};
 	}
 
+	if (open_mode & fs::trunc)
+	{
+		g_fxo->get<named_thread<lv2_fs_readahead>>().invalidate(file);
+	}
+
+	if (mp.read_only && file.size() >= 0x10'0000)
+	{
+		// Files on read-only devices cannot change while mapped, serve reads of large assets from the page cache
+		file.map_readonly();
+	}
+
 	if (type >= lv2_file_type::sdata)
 	{
 		// check for sdata
@@ -1122,7 +1717,9 @@ error_code sys_fs_read(ppu_thread& ppu, u32 fd, vm::ptr<void> buf, u64 nbytes, v
 		return CELL_OK;
 	}
 
-	std::unique_lock lock(file->mp->mutex);
+	// Only the file position needs exclusive access, other files on the mount point can be read concurrently
+	std::shared_lock lock(file->mp->mutex);
+	std::unique_lock pos_lock(file->pos_mutex);
 
 	if (!file->file)
 	{
@@ -1135,8 +1732,29 @@ error_code sys_fs_read(ppu_thread& ppu, u32 fd, vm::ptr<void> buf, u64 nbytes, v
 		return CELL_EIO;
 	}
 
-	const u64 read_bytes = file->op_read(buf, nbytes);
+	auto& readahead = g_fxo->get<named_thread<lv2_fs_readahead>>();
+	const bool use_readahead = readahead.is_eligible(*file, nbytes);
+	const u64 pos = use_readahead ? file->file.pos() : 0;
+
+	u64 read_bytes = 0;
+
+	if (use_readahead && readahead.read(*file, pos, static_cast<u8*>(buf.get_ptr()), nbytes))
+	{
+		file->file.seek(pos + nbytes);
+		read_bytes = nbytes;
+	}
+	else
+	{
+		read_bytes = g_fxo->get<lv2_fs_read_stats>().measure([&]() { return file->op_read(buf, nbytes); });
+	}
+
+	if (use_readahead)
+	{
+		readahead.access(file, pos, read_bytes);
+	}
+
 	const bool failure = !read_bytes && file->file.pos() < file->file.size();
+	pos_lock.unlock();
 	lock.unlock();
 	ppu.check_state();
 
@@ -1273,6 +1891,8 @@ error_code sys_fs_close(ppu_thread& ppu, u32 fd)
 			sys_fs.warning("%s: %s", FD_state_log, *file);
 		}
 
+		g_fxo->get<named_thread<lv2_fs_readahead>>().forget(*file);
+
 		// Free memory associated with fd if any
 		if (file->ct_id && file->ct_used)
 		{
@@ -1994,6 +2614,7 @@ error_code sys_fs_fcntl(ppu_thread& ppu, u32 fd, u32 op, vm::ptr<void> _arg, u32
 
 		std::unique_lock wlock(file->mp->mutex, std::defer_lock);
 		std::shared_lock rlock(file->mp->mutex, std::defer_lock);
+		std::shared_lock pos_lock(file->pos_mutex, std::defer_lock);
 
 		if (op == 0x8000000b)
 		{
@@ -2004,6 +2625,9 @@ error_code sys_fs_fcntl(ppu_thread& ppu, u32 fd, u32 op, vm::ptr<void> _arg, u32
 		{
 			// Reader lock (not needing exclusivity in this special case because the state should not change)
 			rlock.lock();
+
+			// Exclude sys_fs_read which may use the native file position
+			pos_lock.lock();
 		}
 
 		if (!file->file)
@@ -2030,9 +2654,30 @@ error_code sys_fs_fcntl(ppu_thread& ppu, u32 fd, u32 op, vm::ptr<void> _arg, u32
 			file->file.seek(op_pos);
 		}
 
-		arg->out_size = op == 0x8000000a
-			? file->op_read(arg->buf, arg->size, op_pos)
-			: file->op_write(arg->buf, arg->size);
+		if (op == 0x8000000a)
+		{
+			auto& readahead = g_fxo->get<named_thread<lv2_fs_readahead>>();
+			const u64 size = arg->size;
+			const bool use_readahead = readahead.is_eligible(*file, size);
+
+			if (use_readahead && readahead.read(*file, op_pos, static_cast<u8*>(arg->buf.get_ptr()), size))
+			{
+				arg->out_size = size;
+			}
+			else
+			{
+				arg->out_size = g_fxo->get<lv2_fs_read_stats>().measure([&]() { return file->op_read(arg->buf, size, op_pos); });
+			}
+
+			if (use_readahead)
+			{
+				readahead.access(file, op_pos, arg->out_size);
+			}
+		}
+		else
+		{
+			arg->out_size = file->op_write(arg->buf, arg->size);
+		}
 
 		if (op == 0x8000000b)
 		{
@@ -2809,6 +3454,7 @@ error_code sys_fs_truncate(ppu_thread& ppu, vm::cptr<char> path, u64 size)
 		return {CELL_EIO, path}; // ???
 	}
 
+	g_fxo->get<named_thread<lv2_fs_readahead>>().invalidate(local_path);
 	return CELL_OK;
 }
 
@@ -2859,6 +3505,7 @@ error_code sys_fs_ftruncate(ppu_thread& ppu, u32 fd, u64 size)
 		return CELL_EIO; // ???
 	}
 
+	g_fxo->get<named_thread<lv2_fs_readahead>>().invalidate(file->file);
 	return CELL_OK;
 }
 
@@ -274,6 +274,8 @@ public:
 	void save(utils::serial&) {}
 };
 
+struct lv2_event_queue;
+
 struct lv2_file final : lv2_fs_object
 {
 	static constexpr u32 id_type = 1;
@@ -290,6 +292,15 @@ struct lv2_file final : lv2_fs_object
 	// Stream lock
 	atomic_t<u32> lock{0};
 
+	// Reading with the file position under shared mount point lock (reading with explicit offset shares it)
+	mutable shared_mutex pos_mutex;
+
+	// Sequential read detection for read-ahead (protected by the read-ahead mutex)
+	u64 ra_id = 0;
+	u64 ra_next = 0;
+	u32 ra_streak = 0;
+	std::string ra_key; // Host file ID
+
 	// Some variables for convenience of data restoration
 	struct save_restore_t
 	{
@@ -356,6 +367,9 @@ struct lv2_file final : lv2_fs_object
 		return op_write(file, buf, size);
 	}
 
+	// Read or write at the offset on the I/O thread pool, completion is sent to the queue as (source, data1, error, transferred size)
+	static CellError submit_aio(shared_ptr<lv2_file> file, bool write, u64 offset, vm::ptr<void> buf, u64 size, shared_ptr<lv2_event_queue> queue, u64 source, u64 data1);
+
 	// For MSELF support
 	struct file_view;
 
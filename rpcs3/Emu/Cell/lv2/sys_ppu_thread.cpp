@@ -364,7 +364,7 @@ error_code sys_ppu_thread_get_priority(ppu_thread& ppu, u32 thread_id, vm::ptr<s
 		// Fast path for self
 		for (; !ppu.is_stopped(); std::this_thread::yield())
 		{
-			if (reader_lock lock(lv2_obj::g_mutex); cpu_flag::suspend - ppu.state)
+			if (lv2_scheduler_lock<true> lock; cpu_flag::suspend - ppu.state)
 			{
 				prio = ppu.prio.load().prio;
 				break;
@@ -384,7 +384,7 @@ error_code sys_ppu_thread_get_priority(ppu_thread& ppu, u32 thread_id, vm::ptr<s
 		bool check_state = false;
 		const auto thread = idm::check<named_thread<ppu_thread>>(thread_id, [&](ppu_thread& thread)
 		{
-			if (reader_lock lock(lv2_obj::g_mutex); cpu_flag::suspend - ppu.state)
+			if (lv2_scheduler_lock<true> lock; cpu_flag::suspend - ppu.state)
 			{
 				prio = thread.prio.load().prio;
 			}
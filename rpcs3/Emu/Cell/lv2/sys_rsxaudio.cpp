@@ -5,6 +5,8 @@
 #include "Emu/system_config.h"
 #include "Emu//Cell/Modules/cellAudioOut.h"
 #include "util/video_provider.h"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 #include "sys_process.h"
 #include "sys_rsxaudio.h"
@@ -830,7 +832,7 @@ void rsxaudio_data_thread::extract_audio_data()
 		return;
 	}
 
-	std::lock_guard<shared_mutex> rsxaudio_lock(rsxaudio_obj->mutex);
+	std::unique_lock<shared_mutex> rsxaudio_lock(rsxaudio_obj->mutex);
 
 	if (!rsxaudio_obj->init)
 	{
@@ -842,6 +844,10 @@ void rsxaudio_data_thread::extract_audio_data()
 	const auto hw_cfg       = hw_param_ts.get_current();
 	const u64 crnt_time     = get_system_time();
 
+	// Events are sent after releasing the object lock, so woken up guest threads don't contend with this thread
+	std::array<std::pair<shared_ptr<lv2_event_queue>, lv2_event>, SYS_RSXAUDIO_PORT_CNT> events{};
+	u32 event_cnt = 0;
+
 	auto process_rb = [&](RsxaudioPort dst, bool dma_en)
 	{
 		// SPDIF channel data and underflow events are always disabled by lv1
@@ -861,7 +867,7 @@ void rsxaudio_data_thread::extract_audio_data()
 
 				if (const auto& queue = rsxaudio_obj->event_queue[dst_raw])
 				{
-					queue->send(rsxaudio_obj->event_port_name[dst_raw], dst_raw, blk_idx, timestamp);
+					events[event_cnt++] = {queue, lv2_event{rsxaudio_obj->event_port_name[dst_raw], dst_raw, blk_idx, timestamp}};
 				}
 			}
 		}
@@ -890,6 +896,13 @@ void rsxaudio_data_thread::extract_audio_data()
 	{
 		process_rb(RsxaudioPort::SPDIF_1, hw_cfg->spdif[1].dma_en);
 	}
+
+	rsxaudio_lock.unlock();
+
+	for (u32 i = 0; i < event_cnt; i++)
+	{
+		events[i].first->send(events[i].second);
+	}
 }
 
 std::pair<bool, void*> rsxaudio_data_thread::get_ringbuf_addr(RsxaudioPort dst, const lv2_rsxaudio& rsxaudio_obj)
@@ -1187,38 +1200,95 @@ f32 rsxaudio_data_thread::pcm_to_float(s16 sample)
 	return sample * (1.0f / 32768.0f);
 }
 
+void rsxaudio_data_thread::pcm_to_float_be(RsxaudioSampleSize word_bits, const void* buf_in, f32* buf_out, u32 sample_cnt)
+{
+	u32 i = 0;
+
+	if (word_bits == RsxaudioSampleSize::_16BIT)
+	{
+		const auto src = static_cast<const u8*>(buf_in);
+
+		for (; i + 8 <= sample_cnt; i += 8)
+		{
+			// Swap bytes and place each sample into the upper half of a 32-bit lane
+			v128 x = v128::loadu(src + i * 2);
+			x = gv_or32(gv_shl16(x, 8), gv_shr16(x, 8));
+			v128::storeu(gv_mulfs(gv_cvts32_tofs(gv_unpacklo16(v128{}, x)), 1.0f / 2147483648.0f), buf_out + i);
+			v128::storeu(gv_mulfs(gv_cvts32_tofs(gv_unpackhi16(v128{}, x)), 1.0f / 2147483648.0f), buf_out + i + 4);
+		}
+
+		for (; i < sample_cnt; i++)
+		{
+			buf_out[i] = pcm_to_float(static_cast<const be_t<s16>*>(buf_in)[i]);
+		}
+	}
+	else
+	{
+		const auto src = static_cast<const u8*>(buf_in);
+
+		for (; i + 4 <= sample_cnt; i += 4)
+		{
+			v128::storeu(gv_mulfs(gv_cvts32_tofs(gv_to_be32(v128::loadu(src + i * 4))), 1.0f / 2147483648.0f), buf_out + i);
+		}
+
+		// Looks like rsx treats 20bit/24bit samples as 32bit ones
+		for (; i < sample_cnt; i++)
+		{
+			buf_out[i] = pcm_to_float(static_cast<const be_t<s32>*>(buf_in)[i]);
+		}
+	}
+}
+
 void rsxaudio_data_thread::pcm_serial_process_channel(RsxaudioSampleSize word_bits, ra_stream_blk_t& buf_out_l, ra_stream_blk_t& buf_out_r, const void* buf_in, u8 src_stream)
 {
 	const u8 input_word_sz = static_cast<u8>(word_bits);
-	u64 ch_dst = 0;
+	const u32 sample_cnt = (SYS_RSXAUDIO_DATA_BLK_SIZE / 2) / input_word_sz;
 
 	for (u64 blk_idx = 0; blk_idx < SYS_RSXAUDIO_STREAM_DATA_BLK_CNT; blk_idx++)
 	{
-		for (u64 offset = 0; offset < SYS_RSXAUDIO_DATA_BLK_SIZE / 2; offset += input_word_sz, ch_dst++)
-		{
-			const u64 left_ch_src = (blk_idx * SYS_RSXAUDIO_STREAM_SIZE + src_stream * SYS_RSXAUDIO_DATA_BLK_SIZE + offset) / input_word_sz;
-			const u64 right_ch_src = left_ch_src + (SYS_RSXAUDIO_DATA_BLK_SIZE / 2) / input_word_sz;
+		// Each data block holds left channel samples followed by right channel samples
+		const auto blk = static_cast<const u8*>(buf_in) + blk_idx * SYS_RSXAUDIO_STREAM_SIZE + src_stream * SYS_RSXAUDIO_DATA_BLK_SIZE;
 
-			if (word_bits == RsxaudioSampleSize::_16BIT)
-			{
-				buf_out_l[ch_dst] = pcm_to_float(static_cast<const be_t<s16>*>(buf_in)[left_ch_src]);
-				buf_out_r[ch_dst] = pcm_to_float(static_cast<const be_t<s16>*>(buf_in)[right_ch_src]);
-			}
-			else
-			{
-				// Looks like rsx treats 20bit/24bit samples as 32bit ones
-				buf_out_l[ch_dst] = pcm_to_float(static_cast<const be_t<s32>*>(buf_in)[left_ch_src]);
-				buf_out_r[ch_dst] = pcm_to_float(static_cast<const be_t<s32>*>(buf_in)[right_ch_src]);
-			}
-		}
+		pcm_to_float_be(word_bits, blk, buf_out_l.data() + blk_idx * sample_cnt, sample_cnt);
+		pcm_to_float_be(word_bits, blk + SYS_RSXAUDIO_DATA_BLK_SIZE / 2, buf_out_r.data() + blk_idx * sample_cnt, sample_cnt);
 	}
 }
 
 void rsxaudio_data_thread::pcm_spdif_process_channel(RsxaudioSampleSize word_bits, ra_stream_blk_t& buf_out_l, ra_stream_blk_t& buf_out_r, const void* buf_in)
 {
 	const u8 input_word_sz = static_cast<u8>(word_bits);
+	const u32 frame_cnt = SYS_RSXAUDIO_RINGBUF_BLK_SZ_SPDIF / (input_word_sz * SYS_RSXAUDIO_SPDIF_MAX_CH);
+	const auto src = static_cast<const u8*>(buf_in);
+
+	// Deinterleave 4 frames at a time: {L0 R0 L1 R1}, {L2 R2 L3 R3} -> {L0 L1 L2 L3}, {R0 R1 R2 R3}
+	const auto deinterleave = [&](const v128& v0, const v128& v1, u32 offset)
+	{
+		const v128 a = gv_unpacklo32(v0, v1);
+		const v128 b = gv_unpackhi32(v0, v1);
+		v128::storeu(gv_mulfs(gv_cvts32_tofs(gv_unpacklo32(a, b)), 1.0f / 2147483648.0f), &buf_out_l[offset]);
+		v128::storeu(gv_mulfs(gv_cvts32_tofs(gv_unpackhi32(a, b)), 1.0f / 2147483648.0f), &buf_out_r[offset]);
+	};
+
+	u32 offset = 0;
+
+	if (word_bits == RsxaudioSampleSize::_16BIT)
+	{
+		for (; offset + 4 <= frame_cnt; offset += 4)
+		{
+			v128 x = v128::loadu(src + offset * 4);
+			x = gv_or32(gv_shl16(x, 8), gv_shr16(x, 8));
+			deinterleave(gv_unpacklo16(v128{}, x), gv_unpackhi16(v128{}, x), offset);
+		}
+	}
+	else
+	{
+		for (; offset + 4 <= frame_cnt; offset += 4)
+		{
+			deinterleave(gv_to_be32(v128::loadu(src + offset * 8)), gv_to_be32(v128::loadu(src + offset * 8 + 16)), offset);
+		}
+	}
 
-	for (u64 offset = 0; offset < SYS_RSXAUDIO_RINGBUF_BLK_SZ_SPDIF / (input_word_sz * SYS_RSXAUDIO_SPDIF_MAX_CH); offset++)
+	for (; offset < frame_cnt; offset++)
 	{
 		const u64 left_ch_src = offset * SYS_RSXAUDIO_SPDIF_MAX_CH;
 		const u64 right_ch_src = left_ch_src + 1;
@@ -1319,6 +1389,11 @@ rsxaudio_backend_thread::rsxaudio_backend_thread()
 
 rsxaudio_backend_thread::~rsxaudio_backend_thread()
 {
+	if (underrun_cnt || dropped_blk_cnt)
+	{
+		sys_rsxaudio.notice("Backend statistics: %u underruns, %u dropped blocks, max latency %uus", underrun_cnt.load(), dropped_blk_cnt.load(), max_latency_us.load());
+	}
+
 	if (backend)
 	{
 		backend->Close();
@@ -1688,6 +1763,10 @@ void rsxaudio_backend_thread::add_data(rsxaudio_data_container& cont)
 				cont.get_data(cb_cfg.avport_idx, in_data_blk);
 				aux_ringbuf.push(in_data_blk.data(), len);
 			}
+			else
+			{
+				dropped_blk_cnt++;
+			}
 		}
 		else
 		{
@@ -1696,6 +1775,10 @@ void rsxaudio_backend_thread::add_data(rsxaudio_data_container& cont)
 				cont.get_data(cb_cfg.avport_idx, in_data_blk);
 				ringbuf.push(in_data_blk.data(), len);
 			}
+			else
+			{
+				dropped_blk_cnt++;
+			}
 		}
 	}
 }
@@ -1844,7 +1927,18 @@ u32 rsxaudio_backend_thread::write_data_callback(u32 bytes, void* buf)
 
 		ensure(callback_tmp_buf.size() * static_cast<u32>(AudioSampleSize::FLOAT) >= bytes_from_rb);
 
+		const u64 latency_us = ringbuf.get_used_size() * 1'000'000 / (u64{cb_cfg.freq} * cb_cfg.input_ch_cnt * static_cast<u32>(AudioSampleSize::FLOAT));
+		max_latency_us.fetch_op([&](u64& val)
+		{
+			val = std::max(val, latency_us);
+		});
+
 		const u32 byte_cnt = static_cast<u32>(ringbuf.pop(callback_tmp_buf.data(), bytes_from_rb, true));
+
+		if (byte_cnt < bytes_from_rb)
+		{
+			underrun_cnt++;
+		}
 		const u32 sample_cnt = byte_cnt / static_cast<u32>(AudioSampleSize::FLOAT);
 		const u32 sample_cnt_out = sample_cnt / cb_cfg.input_ch_cnt * output_ch_cnt;
 
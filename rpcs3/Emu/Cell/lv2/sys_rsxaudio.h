@@ -556,6 +556,11 @@ private:
 	AudioDumper dumper{};
 	audio_resampler resampler{};
 
+	// Statistics
+	atomic_t<u64> underrun_cnt = 0;
+	atomic_t<u64> dropped_blk_cnt = 0;
+	atomic_t<u64> max_latency_us = 0;
+
 	// Backend
 	void backend_init(const rsxaudio_state& ra_state, const emu_audio_cfg& emu_cfg, bool reset_backend = true);
 	void backend_start();
@@ -610,6 +615,7 @@ private:
 
 	static f32 pcm_to_float(s32 sample);
 	static f32 pcm_to_float(s16 sample);
+	static void pcm_to_float_be(RsxaudioSampleSize word_bits, const void* buf_in, f32* buf_out, u32 sample_cnt);
 	static void pcm_serial_process_channel(RsxaudioSampleSize word_bits, ra_stream_blk_t& buf_out_l, ra_stream_blk_t& buf_out_r, const void* buf_in, u8 src_stream);
 	static void pcm_spdif_process_channel(RsxaudioSampleSize word_bits, ra_stream_blk_t& buf_out_l, ra_stream_blk_t& buf_out_r, const void* buf_in);
 	bool enqueue_data(RsxaudioPort dst, bool silence, const void* src_addr, const rsxaudio_hw_param_t& hwp);
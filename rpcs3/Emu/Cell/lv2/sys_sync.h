@@ -523,9 +523,15 @@ public:
 		}
 	};
 
-	// Scheduler mutex
+	// Scheduler mutex (lock it through lv2_scheduler_lock to have contention counted)
 	static shared_mutex g_mutex;
 
+	// Record an acquisition of g_mutex which had to block
+	static void count_scheduler_contention() noexcept;
+
+	// Record how late a sys_timer expiration was delivered (in guest microseconds)
+	static void record_timer_lateness(u64 lateness) noexcept;
+
 	// Proirity tags
 	static atomic_t<u64> g_priority_order_tag;
 
@@ -547,3 +553,42 @@ private:
 
 	static void schedule_all(u64 current_time = 0);
 };
+
+// Lock of lv2_obj::g_mutex which counts contended acquisitions
+template <bool Shared = false>
+class lv2_scheduler_lock final
+{
+public:
+	lv2_scheduler_lock() noexcept
+	{
+		if (Shared ? !lv2_obj::g_mutex.try_lock_shared() : !lv2_obj::g_mutex.try_lock())
+		{
+			lv2_obj::count_scheduler_contention();
+
+			if constexpr (Shared)
+			{
+				lv2_obj::g_mutex.lock_shared();
+			}
+			else
+			{
+				lv2_obj::g_mutex.lock();
+			}
+		}
+	}
+
+	lv2_scheduler_lock(const lv2_scheduler_lock&) = delete;
+
+	lv2_scheduler_lock& operator=(const lv2_scheduler_lock&) = delete;
+
+	~lv2_scheduler_lock() noexcept
+	{
+		if constexpr (Shared)
+		{
+			lv2_obj::g_mutex.unlock_shared();
+		}
+		else
+		{
+			lv2_obj::g_mutex.unlock();
+		}
+	}
+};
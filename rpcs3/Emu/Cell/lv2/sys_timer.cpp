@@ -17,6 +17,9 @@
 
 LOG_CHANNEL(sys_timer);
 
+// Timers are not registered in the scheduler's timeout wheel (lv2.cpp): it holds waiting threads only
+// and is advanced by schedule_all() under lv2_obj::g_mutex, which would delay expirations until
+// some thread enters the scheduler. Their lateness is recorded with lv2_obj::record_timer_lateness().
 struct lv2_timer_thread
 {
 	shared_mutex mutex;
@@ -90,6 +93,8 @@ u64 lv2_timer::check_unlocked(u64 _now) noexcept
 		port->send(source, data1, data2, next);
 	}
 
+	lv2_obj::record_timer_lateness(_now - next);
+
 	if (period)
 	{
 		// Set next expiration time and check again
@@ -12,6 +12,7 @@
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/Cell/SPURecompiler.h"
 #include "Emu/perf_meter.hpp"
+#include "Emu/Cell/timers.hpp"
 #include <deque>
 #include <span>
 
@@ -84,6 +85,16 @@ namespace vm
 	// Memory range lock slots (sparse atomics)
 	atomic_t<u64, 64> g_range_lock_set[64]{};
 
+	// Overflow shards of reader-only range lock slots, used when g_range_lock_set is full
+	static constexpr u32 range_lock_shards = 3;
+
+	atomic_t<u64, 64> g_range_lock_shard_bits[range_lock_shards]{};
+	atomic_t<u64, 64> g_range_lock_shard_set[range_lock_shards][64]{};
+
+	// Range lock statistics: slow path entries, writer waits for readers
+	atomic_t<u64> g_range_lock_fallbacks = 0;
+	atomic_t<u64> g_range_lock_writer_waits = 0;
+
 	// Memory pages
 	std::array<memory_page, 0x100000000 / 4096> g_pages;
 
@@ -159,21 +170,52 @@ namespace vm
 			return false;
 		});
 
-		if (!ok) [[unlikely]]
+		if (ok) [[likely]]
 		{
-			fmt::throw_exception("Out of range lock bits");
+			return &g_range_lock_set[std::countr_one(bits)];
 		}
 
-		return &g_range_lock_set[std::countr_one(bits)];
+		// Reader-only slots (cannot be used for exclusive range locking)
+		for (u32 shard = 0; shard < range_lock_shards; shard++)
+		{
+			const auto [bits, ok] = g_range_lock_shard_bits[shard].fetch_op([](u64& bits)
+			{
+				if (~bits)
+				{
+					bits |= bits + 1;
+					return true;
+				}
+
+				return false;
+			});
+
+			if (ok)
+			{
+				return &g_range_lock_shard_set[shard][std::countr_one(bits)];
+			}
+		}
+
+		fmt::throw_exception("Out of range lock bits");
 	}
 
+	static bool is_shard_range_lock(const atomic_t<u64, 64>* range_lock)
+	{
+		return range_lock >= g_range_lock_shard_set[0] && range_lock < std::end(g_range_lock_shard_set[range_lock_shards - 1]);
+	}
+
+	template <typename F>
+	static u64 for_all_range_locks(u64 input, F func, atomic_t<u64, 64>* set = g_range_lock_set);
+
+	// Wait until readers in overflow shards don't hold ranges matching func
 	template <typename F>
-	static u64 for_all_range_locks(u64 input, F func);
+	static void wait_for_shard_range_locks(F func);
 
 	void range_lock_internal(atomic_t<u64, 64>* range_lock, u32 begin, u32 size)
 	{
 		perf_meter<"RHW_LOCK"_u64> perf0(0);
 
+		g_range_lock_fallbacks++;
+
 		cpu_thread* _cpu = nullptr;
 
 		if (u64 to_store = begin | (u64{size} << 32); *range_lock != to_store)
@@ -280,6 +322,15 @@ namespace vm
 
 	void free_range_lock(atomic_t<u64, 64>* range_lock) noexcept
 	{
+		if (is_shard_range_lock(range_lock))
+		{
+			range_lock->release(0);
+
+			const auto diff = range_lock - g_range_lock_shard_set[0];
+			g_range_lock_shard_bits[diff / 64] &= ~(1ull << (diff % 64));
+			return;
+		}
+
 		if (range_lock < g_range_lock_set || range_lock >= std::end(g_range_lock_set))
 		{
 			fmt::throw_exception("Invalid range lock");
@@ -293,7 +344,7 @@ namespace vm
 	}
 
 	template <typename F>
-	FORCE_INLINE static u64 for_all_range_locks(u64 input, F func)
+	FORCE_INLINE static u64 for_all_range_locks(u64 input, F func, atomic_t<u64, 64>* set)
 	{
 		u64 result = input;
 
@@ -301,7 +352,7 @@ namespace vm
 		{
 			const u32 id = std::countr_zero(bits);
 
-			const u64 lock_val = g_range_lock_set[id].load();
+			const u64 lock_val = set[id].load();
 
 			if (const u32 size = static_cast<u32>(lock_val >> 32)) [[unlikely]]
 			{
@@ -319,6 +370,30 @@ namespace vm
 		return result;
 	}
 
+	template <typename F>
+	FORCE_INLINE static void wait_for_shard_range_locks(F func)
+	{
+		for (u32 shard = 0; shard < range_lock_shards; shard++)
+		{
+			for (u64 to_clear = g_range_lock_shard_bits[shard].load(), waited = 0; to_clear; waited++)
+			{
+				to_clear = for_all_range_locks(to_clear, func, g_range_lock_shard_set[shard]);
+
+				if (!to_clear) [[likely]]
+				{
+					break;
+				}
+
+				if (!waited)
+				{
+					g_range_lock_writer_waits++;
+				}
+
+				utils::pause();
+			}
+		}
+	}
+
 	static atomic_t<u64, 64>* _lock_main_range_lock(u64 flags, u32 addr, u32 size)
 	{
 		// Shouldn't really happen
@@ -346,26 +421,35 @@ namespace vm
 
 		u64 to_clear = get_range_lock_bits(false).load();
 
-		while (to_clear)
+		const auto overlaps = [&](u32 addr2, u32 size2)
 		{
-			to_clear = for_all_range_locks(to_clear, [&](u32 addr2, u32 size2)
+			if (range.overlaps(utils::address_range::start_length(addr2, size2))) [[unlikely]]
 			{
-				if (range.overlaps(utils::address_range::start_length(addr2, size2))) [[unlikely]]
-				{
-					return 1;
-				}
+				return 1;
+			}
 
-				return 0;
-			});
+			return 0;
+		};
+
+		for (bool waited = false; to_clear;)
+		{
+			to_clear = for_all_range_locks(to_clear, overlaps);
 
 			if (!to_clear) [[likely]]
 			{
 				break;
 			}
 
+			if (!std::exchange(waited, true))
+			{
+				g_range_lock_writer_waits++;
+			}
+
 			utils::pause();
 		}
 
+		wait_for_shard_range_locks(overlaps);
+
 		return range_lock;
 	}
 
@@ -464,8 +548,11 @@ namespace vm
 	}
 
 	writer_lock::writer_lock(u32 const addr, atomic_t<u64, 64>* range_lock, u32 const size, u64 const flags) noexcept
-		: range_lock(range_lock)
+		: range_lock(is_shard_range_lock(range_lock) ? nullptr : range_lock)
 	{
+		// Reader-only slots have no exclusive bit, take the full lock instead
+		range_lock = this->range_lock;
+
 		cpu_thread* cpu{};
 
 		if (g_tls_locked)
@@ -559,38 +646,45 @@ namespace vm
 
 			u64 point = addr1 / 128;
 
-			while (true)
+			const auto overlaps = [&](u64 addr2, u32 size2)
 			{
-				to_clear = for_all_range_locks(to_clear & ~get_range_lock_bits(true), [&](u64 addr2, u32 size2)
+				// Split and check every 64K page separately
+				for (u64 hi = addr2 >> 16, max = (addr2 + size2 - 1) >> 16; hi <= max; hi++)
 				{
-					// Split and check every 64K page separately
-					for (u64 hi = addr2 >> 16, max = (addr2 + size2 - 1) >> 16; hi <= max; hi++)
+					u64 addr3 = addr2;
+					u64 size3 = std::min<u64>(addr2 + size2, utils::align(addr2, 0x10000)) - addr2;
+
+					if (u64 is_shared = g_shmem[hi]) [[unlikely]]
 					{
-						u64 addr3 = addr2;
-						u64 size3 = std::min<u64>(addr2 + size2, utils::align(addr2, 0x10000)) - addr2;
+						addr3 = static_cast<u16>(addr2) | is_shared;
+					}
 
-						if (u64 is_shared = g_shmem[hi]) [[unlikely]]
-						{
-							addr3 = static_cast<u16>(addr2) | is_shared;
-						}
+					if (point - (addr3 / 128) <= (addr3 + size3 - 1) / 128 - (addr3 / 128)) [[unlikely]]
+					{
+						return 1;
+					}
 
-						if (point - (addr3 / 128) <= (addr3 + size3 - 1) / 128 - (addr3 / 128)) [[unlikely]]
-						{
-							return 1;
-						}
+					addr2 += size3;
+					size2 -= static_cast<u32>(size3);
+				}
 
-						addr2 += size3;
-						size2 -= static_cast<u32>(size3);
-					}
+				return 0;
+			};
 
-					return 0;
-				});
+			for (bool waited = false;;)
+			{
+				to_clear = for_all_range_locks(to_clear & ~get_range_lock_bits(true), overlaps);
 
 				if (!to_clear) [[likely]]
 				{
 					break;
 				}
 
+				if (!std::exchange(waited, true))
+				{
+					g_range_lock_writer_waits++;
+				}
+
 				if (to_prepare_memory)
 				{
 					utils::prefetch_write(vm::get_super_ptr(addr));
@@ -601,6 +695,8 @@ namespace vm
 				utils::pause();
 			}
 
+			wait_for_shard_range_locks(overlaps);
+
 			for (auto lock = g_locks.cbegin(), end = lock + g_cfg.core.ppu_threads; lock != end; lock++)
 			{
 				if (auto ptr = +*lock)
@@ -2191,6 +2287,65 @@ namespace vm
 		return result;
 	}
 
+	std::string range_lock_benchmark(u32 threads, u32 iterations)
+	{
+		// Every thread owns a 64K area and shares another one with all threads
+		const u32 base = vm::alloc((threads + 1) * 0x10000, vm::main);
+
+		if (!base)
+		{
+			return "Failed to allocate memory";
+		}
+
+		const u64 fallbacks = g_range_lock_fallbacks;
+		const u64 writer_waits = g_range_lock_writer_waits;
+
+		atomic_t<u32> index = 0;
+
+		const u64 start = get_system_time();
+
+		named_thread_group workers("Range Lock Bench "sv, threads, [&]()
+		{
+			const auto slot = alloc_range_lock();
+			const u32 id = index++;
+
+			u64 seed = id + 1;
+
+			for (u32 i = 0; i < iterations; i++)
+			{
+				seed = seed * 6364136223846793005 + 1442695040888963407;
+
+				// DMA-sized transfers (128 bytes to 16K) alternating between the private and the shared area
+				const u32 size = 128u << ((seed >> 40) % 8);
+				const u32 area = base + (i % 2 ? 0 : (id + 1) * 0x10000);
+				const u32 addr = area + (static_cast<u32>(seed >> 48) % (0x10000 - size) & -128);
+
+				if (i % 64 == 63)
+				{
+					// Occasional reservation store
+					writer_lock lock(addr, slot);
+					continue;
+				}
+
+				vm::range_lock(slot, addr, size);
+				slot->release(0);
+			}
+
+			free_range_lock(slot);
+		});
+
+		workers.join();
+
+		const u64 elapsed = std::max<u64>(get_system_time() - start, 1);
+		const u64 total = u64{threads} * iterations;
+
+		vm::dealloc(base, vm::main);
+
+		return fmt::format("%u threads: %u range locks in %u us (%.1f ns per lock, %.2f Mlocks/s), %u slow path entries, %u writer waits",
+			threads, total, elapsed, elapsed * 1000. / total, total / static_cast<f64>(elapsed),
+			g_range_lock_fallbacks - fallbacks, g_range_lock_writer_waits - writer_waits);
+	}
+
 	inline namespace ps3_
 	{
 		static utils::shm s_hook{0x800000000, ""};
@@ -2228,6 +2383,8 @@ namespace vm
 			std::memset(g_shmem, 0, sizeof(g_shmem));
 			std::memset(g_range_lock_set, 0, sizeof(g_range_lock_set));
 			std::memset(g_range_lock_bits, 0, sizeof(g_range_lock_bits));
+			std::memset(g_range_lock_shard_set, 0, sizeof(g_range_lock_shard_set));
+			std::memset(g_range_lock_shard_bits, 0, sizeof(g_range_lock_shard_bits));
 
 #ifdef _WIN32
 			utils::memory_release(g_hook_addr, 0x800000000);
@@ -2259,8 +2416,12 @@ namespace vm
 		utils::memory_decommit(g_hook_addr, 0x800000000);
 #endif
 
+		vm_log.notice("Range locks: %u slow path entries, %u writer waits", g_range_lock_fallbacks.exchange(0), g_range_lock_writer_waits.exchange(0));
+
 		std::memset(g_range_lock_set, 0, sizeof(g_range_lock_set));
 		std::memset(g_range_lock_bits, 0, sizeof(g_range_lock_bits));
+		std::memset(g_range_lock_shard_set, 0, sizeof(g_range_lock_shard_set));
+		std::memset(g_range_lock_shard_bits, 0, sizeof(g_range_lock_shard_bits));
 	}
 
 	void save(utils::serial& ar)
@@ -82,6 +82,9 @@ namespace vm
 	// Release it
 	void free_range_lock(atomic_t<u64, 64>*) noexcept;
 
+	// Measure concurrent range locking from many threads (returns a summary)
+	std::string range_lock_benchmark(u32 threads, u32 iterations);
+
 	// Unregister reader
 	void passive_unlock(cpu_thread& cpu);
 
@@ -31,7 +31,7 @@ namespace rsx
 			current_thread_ = thread_ctrl::get_current();
 			ensure(current_thread_);
 
-			if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+			if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os && g_cfg.core.thread_scheduler != thread_scheduler_mode::os_lv2_queues)
 			{
 				thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
 			}
@@ -1130,7 +1130,7 @@ namespace rsx
 		// Raise priority above other threads
 		thread_ctrl::scoped_priority high_prio(+1);
 
-		if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+		if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os && g_cfg.core.thread_scheduler != thread_scheduler_mode::os_lv2_queues)
 		{
 			thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
 		}
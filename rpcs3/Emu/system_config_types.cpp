@@ -144,6 +144,21 @@ void fmt_class_string<audio_channel_layout>::format(std::string& out, u64 arg)
 	});
 }
 
+template <>
+void fmt_class_string<time_stretching_engine>::format(std::string& out, u64 arg)
+{
+	format_enum(out, arg, [](time_stretching_engine value)
+	{
+		switch (value)
+		{
+		case time_stretching_engine::soundtouch: return "SoundTouch";
+		case time_stretching_engine::polyphase: return "Polyphase";
+		}
+
+		return unknown;
+	});
+}
+
 template <>
 void fmt_class_string<detail_level>::format(std::string& out, u64 arg)
 {
@@ -622,6 +637,7 @@ void fmt_class_string<thread_scheduler_mode>::format(std::string& out, u64 arg)
 		case thread_scheduler_mode::old: return "RPCS3 Scheduler";
 		case thread_scheduler_mode::alt: return "RPCS3 Alternative Scheduler";
 		case thread_scheduler_mode::os: return "Operating System";
+		case thread_scheduler_mode::os_lv2_queues: return "Operating System (LV2 Priority Queues)";
 		}
 
 		return unknown;
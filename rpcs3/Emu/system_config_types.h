@@ -106,6 +106,12 @@ enum class audio_channel_layout
 	surround_7_1,
 };
 
+enum class time_stretching_engine
+{
+	soundtouch, // Tempo change without pitch change
+	polyphase,  // Low latency rate change (pitch follows the tempo)
+};
+
 enum class music_handler
 {
 	null,
@@ -299,7 +305,8 @@ enum class thread_scheduler_mode
 {
 	os,
 	old,
-	alt
+	alt,
+	os_lv2_queues, // Operating System, with per-priority LV2 ready queues
 };
 
 enum class perf_graph_detail_level
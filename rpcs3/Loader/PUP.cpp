@@ -2,9 +2,13 @@
 
 #include "Crypto/sha1.h"
 #include "Crypto/key_vault.h"
+#include "Utilities/Thread.h"
+#include "util/sysinfo.hpp"
 
 #include "PUP.h"
 
+fs::file make_file_view(const fs::file& file, u64 offset, u64 size);
+
 pup_object::pup_object(fs::file&& file) : m_file(std::move(file))
 {
 	if (!m_file)
@@ -69,10 +73,8 @@ fs::file pup_object::get_file(u64 entry_id) const
 	{
 		if (file_entry.entry_id == entry_id)
 		{
-			std::vector<u8> file_buf(file_entry.data_length);
-			m_file.seek(file_entry.data_offset);
-			m_file.read(file_buf, file_entry.data_length);
-			return fs::make_stream(std::move(file_buf));
+			// Stream the entry from the PUP file instead of buffering it
+			return make_file_view(m_file, file_entry.data_offset, file_entry.data_length);
 		}
 	}
 
@@ -83,8 +85,6 @@ pup_error pup_object::validate_hashes()
 {
 	AUDIT(m_error == pup_error::ok);
 
-	std::vector<u8> buffer;
-
 	const usz size = m_file.size();
 
 	for (const PUPFileEntry& file : m_file_tbl)
@@ -95,21 +95,49 @@ pup_error pup_object::validate_hashes()
 			m_formatted_error = fmt::format("File database entry is invalid. (offset=0x%x, length=0x%x, PUP.size=0x%x)", file.data_offset, file.data_length, size);
 			return pup_error::file_entries;
 		}
+	}
 
-		// Reuse buffer
-		buffer.resize(file.data_length);
-		m_file.seek(file.data_offset);
-		m_file.read(buffer.data(), file.data_length);
+	// Hash entries in parallel, each worker streams data through a fixed-size buffer
+	atomic_t<usz> index = 0;
+	atomic_t<bool> mismatch = false;
 
-		u8 output[20] = {};
-		sha1_hmac(PUP_KEY, sizeof(PUP_KEY), buffer.data(), buffer.size(), output);
+	const named_thread_group workers("PUP Validator "sv, std::min<u32>({utils::get_thread_count(), ::size32(m_file_tbl), 8}), [&]()
+	{
+		std::vector<u8> buffer(0x10'0000);
 
-		// Compare to hash entry
-		if (std::memcmp(output, m_hash_tbl[&file - m_file_tbl.data()].hash, 20) != 0)
+		for (usz i = index++; i < m_file_tbl.size() && !mismatch; i = index++)
 		{
-			return pup_error::hash_mismatch;
+			const PUPFileEntry& file = m_file_tbl[i];
+
+			sha1_context ctx;
+			sha1_hmac_starts(&ctx, PUP_KEY, sizeof(PUP_KEY));
+
+			for (u64 pos = 0; pos < file.data_length;)
+			{
+				const u64 chunk = std::min<u64>(buffer.size(), file.data_length - pos);
+
+				if (m_file.read_at(file.data_offset + pos, buffer.data(), chunk) != chunk)
+				{
+					mismatch = true;
+					return;
+				}
+
+				sha1_hmac_update(&ctx, buffer.data(), chunk);
+				pos += chunk;
+			}
+
+			u8 output[20] = {};
+			sha1_hmac_finish(&ctx, output);
+
+			// Compare to hash entry
+			if (std::memcmp(output, m_hash_tbl[i].hash, 20) != 0)
+			{
+				mismatch = true;
+			}
 		}
-	}
+	});
+
+	workers.join();
 
-	return pup_error::ok;
+	return mismatch ? pup_error::hash_mismatch : pup_error::ok;
 }
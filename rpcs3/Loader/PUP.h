@@ -62,5 +62,6 @@ public:
 	explicit operator pup_error() const { return m_error; }
 	const std::string& get_formatted_error() const { return m_formatted_error; }
 
+	// Returns a view into the PUP file, it must not outlive this object
 	fs::file get_file(u64 entry_id) const;
 };
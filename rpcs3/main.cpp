@@ -79,6 +79,7 @@ namespace Darwin_Version
 #include "util/media_utils.h"
 #include "rpcs3_version.h"
 #include "Emu/System.h"
+#include "Emu/Memory/vm_locking.h"
 #include "Emu/system_utils.hpp"
 #include <thread>
 #include <charconv>
@@ -317,6 +318,7 @@ private:
 constexpr auto arg_headless     = "headless";
 constexpr auto arg_decrypt      = "decrypt";
 constexpr auto arg_commit_db    = "get-commit-db";
+constexpr auto arg_bench_rlock  = "bench-range-lock";
 
 // Arguments that can be used with a gui application
 constexpr auto arg_no_gui       = "no-gui";
@@ -360,7 +362,8 @@ QCoreApplication* create_application(int& argc, char* argv[])
 {
 	if (find_arg(arg_headless, argc, argv) != -1 ||
 		find_arg(arg_decrypt, argc, argv) != -1 ||
-		find_arg(arg_commit_db, argc, argv) != -1)
+		find_arg(arg_commit_db, argc, argv) != -1 ||
+		find_arg(arg_bench_rlock, argc, argv) != -1)
 	{
 		return new headless_application(argc, argv);
 	}
@@ -721,6 +724,8 @@ int main(int argc, char** argv)
 	parser.addOption(QCommandLineOption(arg_error, "For internal usage."));
 	parser.addOption(QCommandLineOption(arg_updating, "For internal usage."));
 	parser.addOption(QCommandLineOption(arg_commit_db, "Update commits.lst cache. Optional arguments: <path> <sha>"));
+	const QCommandLineOption bench_rlock_option(arg_bench_rlock, "Measure concurrent guest memory range locking.", "threads", "64");
+	parser.addOption(bench_rlock_option);
 	parser.addOption(QCommandLineOption(arg_timer, "Enable high resolution timer for better performance (windows)", "enabled", "1"));
 	parser.addOption(QCommandLineOption(arg_verbose_curl, "Enable verbose curl logging."));
 	parser.addOption(QCommandLineOption(arg_any_location, "Allow RPCS3 to be run from any location. Dangerous"));
@@ -1161,6 +1166,23 @@ int main(int argc, char** argv)
 	}
 #endif
 
+	if (parser.isSet(arg_bench_rlock))
+	{
+		utils::attach_console(utils::console_stream::std_out, true);
+
+		Emu.Init();
+		vm::init();
+
+		// Up to 63 primary range lock slots plus the reader-only shards
+		for (u32 threads : {1u, 8u, std::clamp(parser.value(bench_rlock_option).toUInt(), 1u, 240u)})
+		{
+			std::cout << vm::range_lock_benchmark(threads, 200'000) << std::endl;
+		}
+
+		vm::close();
+		return 0;
+	}
+
 	if (parser.isSet(arg_decrypt))
 	{
 		utils::attach_console(utils::console_stream::std_out | utils::console_stream::std_in, true);
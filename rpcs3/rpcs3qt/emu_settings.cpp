@@ -987,6 +987,7 @@ QString emu_settings::GetLocalizedSetting(const QString& original, emu_settings_
 		case thread_scheduler_mode::old: return tr("RPCS3 Scheduler", "Thread Scheduler Mode");
 		case thread_scheduler_mode::alt: return tr("RPCS3 Alternative Scheduler", "Thread Scheduler Mode");
 		case thread_scheduler_mode::os: return tr("Operating System", "Thread Scheduler Mode");
+		case thread_scheduler_mode::os_lv2_queues: return tr("Operating System (LV2 Priority Queues)", "Thread Scheduler Mode");
 		}
 		break;
 	case emu_settings_type::EnableTSX:
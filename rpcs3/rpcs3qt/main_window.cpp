@@ -1655,11 +1655,25 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 	// Synchronization variable
 	atomic_t<uint> progress(0);
 	{
-		// Run asynchronously
-		named_thread worker("Firmware Installer", [&]
+		// Run asynchronously, packages are independent so they are installed in parallel
+		// Each worker only holds one package in memory at a time, which bounds memory usage
+		atomic_t<usz> package_index = 0;
+
+		named_thread_group workers("Firmware Installer "sv, std::min<u32>({utils::get_thread_count(), ::size32(update_filenames), 4}), [&]
 		{
-			for (const auto& update_filename : update_filenames)
+			const auto fail = [&](QString str)
+			{
+				// Only report the first failure
+				if (progress.exchange(-1) != umax)
+				{
+					critical(std::move(str));
+				}
+			};
+
+			for (usz i = package_index++; i < update_filenames.size() && progress != umax; i = package_index++)
 			{
+				const std::string& update_filename = update_filenames[i];
+
 				auto update_file_stream = update_files.get_file(update_filename);
 
 				if (update_file_stream->m_file_handler)
@@ -1669,6 +1683,7 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 				}
 
 				fs::file update_file = fs::make_stream(std::move(update_file_stream->data));
+				update_file_stream.reset();
 
 				SCEDecrypter self_dec(update_file);
 				self_dec.LoadHeaders();
@@ -1679,8 +1694,7 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 				if (dev_flash_tar_f.size() < 3)
 				{
 					gui_log.error("Error while installing firmware: PUP contents are invalid.");
-					critical(tr("Firmware installation failed: Firmware could not be decompressed"));
-					progress = -1;
+					fail(tr("Firmware installation failed: Firmware could not be decompressed"));
 					return;
 				}
 
@@ -1688,11 +1702,9 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 				if (!dev_flash_tar.extract())
 				{
 					gui_log.error("Error while installing firmware: TAR contents are invalid. (package=%s)", update_filename);
-					critical(tr("The firmware contents could not be extracted."
+					fail(tr("The firmware contents could not be extracted."
 						"\nThis is very likely caused by external interference from a faulty anti-virus software."
 						"\nPlease add RPCS3 to your anti-virus\' whitelist or use better anti-virus software."));
-
-					progress = -1;
 					return;
 				}
 
@@ -1725,8 +1737,8 @@ void main_window::HandlePupInstallation(const QString& file_path, const QString&
 			return false;
 		});
 
-		// Join thread
-		worker();
+		// Join threads
+		workers.join();
 	}
 
 	update_files_f.close();
@@ -5,6 +5,7 @@
 #include "Utilities/StrFmt.h"
 #include <cstring>
 #include <cstdarg>
+#include <array>
 #include <string>
 #include <unordered_map>
 #include <thread>
@@ -12,6 +13,9 @@
 #include <cstring>
 #include <cerrno>
 #include <regex>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 
 using namespace std::literals::chrono_literals;
 
@@ -43,6 +47,66 @@ thread_local std::string(*g_tls_log_prefix)() = &default_string;
 // Another thread-specific callback
 thread_local void(*g_tls_log_control)(const char* fmt, u64 progress) = [](const char*, u64){};
 
+// Set when the thread-specific buffers below are destroyed (messages logged during thread exit)
+constinit thread_local bool g_tls_log_buffers_freed = false;
+
+// Thread-specific formatting buffers (message text and final line)
+struct log_tls_buffers
+{
+	std::string str[2];
+	bool busy[2]{};
+
+	~log_tls_buffers()
+	{
+		g_tls_log_buffers_freed = true;
+	}
+};
+
+thread_local log_tls_buffers g_tls_log_buffers{};
+
+// Borrows a thread-specific buffer to avoid heap allocations for every message, unless it's used by a nested log call
+class log_text_buffer
+{
+	std::string m_local{};
+	std::string* m_tls = nullptr;
+	const usz m_index;
+
+public:
+	explicit log_text_buffer(usz index)
+		: m_index(index)
+	{
+		if (!g_tls_log_buffers_freed && !std::exchange(g_tls_log_buffers.busy[index], true))
+		{
+			m_tls = &g_tls_log_buffers.str[index];
+		}
+	}
+
+	log_text_buffer(const log_text_buffer&) = delete;
+
+	log_text_buffer& operator=(const log_text_buffer&) = delete;
+
+	~log_text_buffer()
+	{
+		if (m_tls)
+		{
+			m_tls->clear();
+
+			// Release memory after an unusually large message
+			if (m_tls->capacity() > 0x10'0000)
+			{
+				m_tls->shrink_to_fit();
+			}
+
+			g_tls_log_buffers.busy[m_index] = false;
+		}
+	}
+
+	std::string& get()
+	{
+		return m_tls ? *m_tls : m_local;
+	}
+};
+
 template<>
 void fmt_class_string<logs::level>::format(std::string& out, u64 arg)
 {
@@ -78,25 +142,56 @@ namespace logs
 	constexpr u64 s_log_size = 32 * 1024 * 1024;
 	static_assert(s_log_size * s_log_size > s_log_size && (s_log_size & (s_log_size - 1)) == 0); // Assert on an overflowing value
 
+	// Max size of the fragment written out in one flush
+	constexpr u64 s_flush_size = 32 * 1024;
+
+	// Size of the independently compressed gzip members
+	constexpr usz s_zblock_size = 1024 * 1024;
+
 	class file_writer
 	{
+		// Log fragment compressed into a separate gzip member by a worker thread
+		struct zblock
+		{
+			std::vector<uchar> in;
+			std::vector<uchar> out;
+			int level = 9;
+			bool done = false;
+			bool ok = false;
+		};
+
 		std::thread m_writer{};
 		fs::file m_fout{};
 		fs::file m_fout2{};
 		u64 m_max_size{};
 
 		std::unique_ptr<uchar[]> m_fptr{};
-		z_stream m_zs{};
 		shared_mutex m_m{};
 
 		atomic_t<u64, 64> m_buf{0}; // MSB (39 bits): push begin, LSB (25 bis): push size
 		atomic_t<u64, 64> m_out{0}; // Amount of bytes written to file
 
-		uchar m_zout[65536]{};
+		std::vector<std::thread> m_zworkers{};
+		std::mutex m_zmutex{};
+		std::condition_variable m_zjob_cv{};
+		std::condition_variable m_zdone_cv{};
+		std::deque<std::shared_ptr<zblock>> m_zqueue{}; // Blocks in output order
+		std::deque<std::shared_ptr<zblock>> m_zjobs{}; // Blocks waiting for a worker
+		std::vector<uchar> m_zpending{}; // Input of the next block
+		bool m_zstop = false;
 
 		// Write buffered logs immediately
 		bool flush(u64 bufv);
 
+		// Compress the pending input as a new block
+		void zsubmit();
+
+		// Write compressed blocks in order (waits for all blocks if requested or if too many are in flight)
+		void zwrite(bool wait_all);
+
+		// Write all remaining data and stop compression workers
+		void zfinish();
+
 	public:
 		file_writer(const std::string& name, u64 max_size);
 
@@ -397,8 +492,8 @@ void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) co
 	g_tls_log_control(fmt, 0);
 
 	// Get text, extract va_args
-	/*constinit thread_local*/ std::string text;
-	/*constinit thread_local*/ std::vector<u64> args;
+	log_text_buffer text_buf(0);
+	std::string& text = text_buf.get();
 
 	static constexpr fmt_type_info empty_sup{};
 
@@ -406,15 +501,23 @@ void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) co
 	for (auto v = sup; v && v->fmt_string; v++)
 		args_count++;
 
-	text.reserve(50000);
-	args.resize(args_count);
+	// Up to 16 arguments are extracted without allocation
+	std::array<u64, 16> small_args;
+	std::vector<u64> large_args;
+
+	if (args_count > small_args.size())
+	{
+		large_args.resize(args_count);
+	}
+
+	u64* const args = large_args.empty() ? small_args.data() : large_args.data();
 
 	va_list c_args;
 	va_start(c_args, sup);
-	for (u64& arg : args)
-		arg = va_arg(c_args, u64);
+	for (usz i = 0; i < args_count; i++)
+		args[i] = va_arg(c_args, u64);
 	va_end(c_args);
-	fmt::raw_append(text, fmt, sup ? sup : &empty_sup, args.data());
+	fmt::raw_append(text, fmt, sup ? sup : &empty_sup, args);
 	std::string prefix = g_tls_log_prefix();
 
 	// Get first (main) listener
@@ -466,26 +569,74 @@ logs::file_writer::file_writer(const std::string& name, u64 max_size)
 	}
 
 	// Compressed log, make it inaccessible (foolproof)
-	if (m_fout2.open(name + ".gz", fs::rewrite + fs::unread))
+	if (!m_fout2.open(name + ".gz", fs::rewrite + fs::unread))
 	{
+		fprintf(stderr, "Log file open failed: %s.gz (error %d)\n", name.c_str(), errno);
+	}
+	else
+	{
+		// The log is written as a sequence of gzip members (a valid .gz file), which are compressed in parallel
+		const u32 worker_count = std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u);
+
+		for (u32 i = 0; i < worker_count; i++)
+		{
+			m_zworkers.emplace_back([this]()
+			{
+				thread_base::set_name("Log Compressor");
+
+				thread_ctrl::scoped_priority low_prio(-1);
+
+				while (true)
+				{
+					std::shared_ptr<zblock> block;
+					{
+						std::unique_lock lock(m_zmutex);
+						m_zjob_cv.wait(lock, [&]() { return m_zstop || !m_zjobs.empty(); });
+
+						if (m_zjobs.empty())
+						{
+							break;
+						}
+
+						block = std::move(m_zjobs.front());
+						m_zjobs.pop_front();
+					}
+
+					z_stream zs{};
+
 #ifndef _MSC_VER
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
 #endif
-		if (deflateInit2(&m_zs, 9, Z_DEFLATED, 16 + 15, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+					if (deflateInit2(&zs, block->level, Z_DEFLATED, 16 + 15, 9, Z_DEFAULT_STRATEGY) == Z_OK)
 #ifndef _MSC_VER
 #pragma GCC diagnostic pop
 #endif
-		{
-			m_fout2.close();
+					{
+						block->out.resize(deflateBound(&zs, static_cast<uLong>(block->in.size())));
+						zs.avail_in = static_cast<uInt>(block->in.size());
+						zs.next_in = block->in.data();
+						zs.avail_out = static_cast<uInt>(block->out.size());
+						zs.next_out = block->out.data();
+
+						const bool ok = deflate(&zs, Z_FINISH) == Z_STREAM_END;
+						block->out.resize(block->out.size() - zs.avail_out);
+						deflateEnd(&zs);
+
+						block->ok = ok;
+					}
+
+					{
+						std::lock_guard lock(m_zmutex);
+						block->done = true;
+					}
+
+					m_zdone_cv.notify_all();
+				}
+			});
 		}
 	}
 
-	if (!m_fout2)
-	{
-		fprintf(stderr, "Log file open failed: %s.gz (error %d)\n", name.c_str(), errno);
-	}
-
 #ifdef _WIN32
 	// Autodelete compressed log file
 	FILE_DISPOSITION_INFO disp{};
@@ -536,25 +687,7 @@ logs::file_writer::~file_writer()
 	m_out = -1;
 	m_writer.join();
 
-	if (m_fout2)
-	{
-		m_zs.avail_in = 0;
-		m_zs.next_in  = nullptr;
-
-		do
-		{
-			m_zs.avail_out = sizeof(m_zout);
-			m_zs.next_out  = m_zout;
-
-			if (deflate(&m_zs, Z_FINISH) == Z_STREAM_ERROR || m_fout2.write(m_zout, sizeof(m_zout) - m_zs.avail_out) != sizeof(m_zout) - m_zs.avail_out)
-			{
-				break;
-			}
-		}
-		while (m_zs.avail_out == 0);
-
-		deflateEnd(&m_zs);
-	}
+	zfinish();
 
 #ifdef _WIN32
 	// Cancel compressed log file auto-deletion
@@ -579,7 +712,7 @@ bool logs::file_writer::flush(u64 bufv)
 	if (end > read_pos)
 	{
 		// Avoid writing too big fragments
-		const u64 size = std::min<u64>(end - read_pos, sizeof(m_zout) / 2);
+		const u64 size = std::min<u64>(end - read_pos, s_flush_size);
 
 		// Write uncompressed
 		if (m_fout && m_fout.write(m_fptr.get() + out_index, size) != size)
@@ -587,34 +720,108 @@ bool logs::file_writer::flush(u64 bufv)
 			m_fout.close();
 		}
 
-		// Write compressed
+		// Queue for compression
 		if (m_fout2)
 		{
-			m_zs.avail_in = static_cast<uInt>(size);
-			m_zs.next_in  = m_fptr.get() + out_index;
+			m_zpending.insert(m_zpending.end(), m_fptr.get() + out_index, m_fptr.get() + out_index + size);
 
-			do
+			if (m_zpending.size() >= s_zblock_size)
 			{
-				m_zs.avail_out = sizeof(m_zout);
-				m_zs.next_out  = m_zout;
-
-				if (deflate(&m_zs, Z_NO_FLUSH) == Z_STREAM_ERROR || m_fout2.write(m_zout, sizeof(m_zout) - m_zs.avail_out) != sizeof(m_zout) - m_zs.avail_out)
-				{
-					deflateEnd(&m_zs);
-					m_fout2.close();
-					break;
-				}
+				zsubmit();
 			}
-			while (m_zs.avail_out == 0);
+
+			zwrite(false);
 		}
 
 		m_out += size;
 		return true;
 	}
 
+	if (m_fout2)
+	{
+		// Write out blocks completed in the meantime
+		zwrite(false);
+	}
+
 	return false;
 }
 
+void logs::file_writer::zsubmit()
+{
+	if (m_zpending.empty() || m_zworkers.empty())
+	{
+		return;
+	}
+
+	auto block = std::make_shared<zblock>();
+	block->in = std::move(m_zpending);
+	m_zpending.clear();
+	m_zpending.reserve(s_zblock_size + s_flush_size);
+
+	{
+		std::lock_guard lock(m_zmutex);
+
+		// Lower compression level when workers fall behind
+		const usz backlog = m_zqueue.size();
+		block->level = backlog < m_zworkers.size() ? 9 : backlog < m_zworkers.size() * 2 ? 6 : 1;
+
+		m_zqueue.push_back(block);
+		m_zjobs.push_back(std::move(block));
+	}
+
+	m_zjob_cv.notify_one();
+}
+
+void logs::file_writer::zwrite(bool wait_all)
+{
+	std::unique_lock lock(m_zmutex);
+
+	while (!m_zqueue.empty())
+	{
+		if (!m_zqueue.front()->done)
+		{
+			if (!wait_all && m_zqueue.size() <= m_zworkers.size() * 4)
+			{
+				break;
+			}
+
+			m_zdone_cv.wait(lock);
+			continue;
+		}
+
+		const auto block = std::move(m_zqueue.front());
+		m_zqueue.pop_front();
+		lock.unlock();
+
+		if (m_fout2 && (!block->ok || m_fout2.write(block->out.data(), block->out.size()) != block->out.size()))
+		{
+			m_fout2.close();
+		}
+
+		lock.lock();
+	}
+}
+
+void logs::file_writer::zfinish()
+{
+	zsubmit();
+	zwrite(true);
+
+	{
+		std::lock_guard lock(m_zmutex);
+		m_zstop = true;
+	}
+
+	m_zjob_cv.notify_all();
+
+	for (auto& worker : m_zworkers)
+	{
+		worker.join();
+	}
+
+	m_zworkers.clear();
+}
+
 void logs::file_writer::log(const char* text, usz size)
 {
 	if (!m_fptr)
@@ -701,6 +908,15 @@ void logs::file_writer::sync()
 		std::this_thread::yield();
 	}
 
+	std::lock_guard lock(m_m);
+
+	if (m_fout2)
+	{
+		// Compress the pending data and write out all queued blocks
+		zsubmit();
+		zwrite(true);
+	}
+
 	// Ensure written to disk
 	if (m_fout)
 	{
@@ -725,25 +941,10 @@ void logs::file_writer::close_prematurely()
 
 	std::lock_guard lock(m_m);
 
+	zfinish();
+
 	if (m_fout2)
 	{
-		m_zs.avail_in = 0;
-		m_zs.next_in  = nullptr;
-
-		do
-		{
-			m_zs.avail_out = sizeof(m_zout);
-			m_zs.next_out  = m_zout;
-
-			if (deflate(&m_zs, Z_FINISH) == Z_STREAM_ERROR || m_fout2.write(m_zout, sizeof(m_zout) - m_zs.avail_out) != sizeof(m_zout) - m_zs.avail_out)
-			{
-				break;
-			}
-		}
-		while (m_zs.avail_out == 0);
-
-		deflateEnd(&m_zs);
-
 #ifdef _WIN32
 		// Cancel compressed log file auto-deletion
 		FILE_DISPOSITION_INFO disp;
@@ -773,8 +974,8 @@ logs::file_listener::file_listener(const std::string& path, u64 max_size)
 
 void logs::file_listener::log(u64 stamp, const logs::message& msg, const std::string& prefix, const std::string& _text)
 {
-	/*constinit thread_local*/ std::string text;
-	text.reserve(50000);
+	log_text_buffer text_buf(1);
+	std::string& text = text_buf.get();
 
 	// Used character: U+00B7 (Middle Dot)
 	switch (msg)
@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "media_utils.h"
 #include "Emu/System.h"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
 
 #include <random>
 
@@ -154,6 +156,121 @@ namespace utils
 		return list_ffmpeg_codecs(false);
 	}
 
+	namespace
+	{
+		// Fixed-point (Q6) YCbCr to RGB coefficients
+		struct yuv_coefs
+		{
+			s16 y_off, y, rv, gu, gv, bu;
+		};
+
+		constexpr yuv_coefs s_yuv_coefs[2][2] =
+		{
+			// Broadcast range: BT.601, BT.709
+			{{ 16, 75, 102, -25, -52, 129 }, { 16, 75, 115, -14, -34, 135 }},
+			// Full range: BT.601, BT.709
+			{{ 0, 64, 90, -22, -46, 113 }, { 0, 64, 101, -12, -30, 119 }},
+		};
+
+		inline u8 yuv_clamp(s32 value)
+		{
+			return static_cast<u8>(std::clamp((value + 32) >> 6, 0, 255));
+		}
+
+		void convert_yuv420_row(const yuv_coefs& c, const u8* y, const u8* u, const u8* v, u8* dst, u32 width, u8 alpha, bool argb)
+		{
+			u32 x = 0;
+
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+			const v128 zero{};
+			const v128 a = gv_bcst8(alpha);
+			const v128 y_off = gv_bcst16(c.y_off);
+			const v128 c_off = gv_bcst16(128);
+			const v128 round = gv_bcst16(32);
+			const v128 cy = gv_bcst16(c.y);
+			const v128 crv = gv_bcst16(c.rv);
+			const v128 cgu = gv_bcst16(c.gu);
+			const v128 cgv = gv_bcst16(c.gv);
+			const v128 cbu = gv_bcst16(c.bu);
+
+			// 16 pixels per iteration, chroma samples are duplicated horizontally
+			for (; x + 16 <= width; x += 16)
+			{
+				u64 u8x8, v8x8;
+				std::memcpy(&u8x8, u + x / 2, 8);
+				std::memcpy(&v8x8, v + x / 2, 8);
+
+				const v128 yv = v128::loadu(y + x);
+				const v128 uv = v128::from64(u8x8);
+				const v128 vv = v128::from64(v8x8);
+				const v128 ud = gv_unpacklo8(uv, uv);
+				const v128 vd = gv_unpacklo8(vv, vv);
+
+				v128 out[2][3];
+
+				for (u32 i = 0; i < 2; i++)
+				{
+					const v128 ys = gv_add16(gv_mul16(gv_sub16(i ? gv_unpackhi8(yv, zero) : gv_unpacklo8(yv, zero), y_off), cy), round);
+					const v128 us = gv_sub16(i ? gv_unpackhi8(ud, zero) : gv_unpacklo8(ud, zero), c_off);
+					const v128 vs = gv_sub16(i ? gv_unpackhi8(vd, zero) : gv_unpacklo8(vd, zero), c_off);
+
+					// Saturating adds keep the out-of-range values clamped
+					out[i][0] = gv_sar16(gv_adds_s16(ys, gv_mul16(vs, crv)), 6);
+					out[i][1] = gv_sar16(gv_adds_s16(gv_adds_s16(ys, gv_mul16(us, cgu)), gv_mul16(vs, cgv)), 6);
+					out[i][2] = gv_sar16(gv_adds_s16(ys, gv_mul16(us, cbu)), 6);
+				}
+
+				const v128 r = gv_packus_s16(out[0][0], out[1][0]);
+				const v128 g = gv_packus_s16(out[0][1], out[1][1]);
+				const v128 b = gv_packus_s16(out[0][2], out[1][2]);
+
+				const v128 lo0 = argb ? gv_unpacklo8(a, r) : gv_unpacklo8(r, g);
+				const v128 hi0 = argb ? gv_unpackhi8(a, r) : gv_unpackhi8(r, g);
+				const v128 lo1 = argb ? gv_unpacklo8(g, b) : gv_unpacklo8(b, a);
+				const v128 hi1 = argb ? gv_unpackhi8(g, b) : gv_unpackhi8(b, a);
+
+				v128::storeu(gv_unpacklo16(lo0, lo1), dst + x * 4, 0);
+				v128::storeu(gv_unpackhi16(lo0, lo1), dst + x * 4, 1);
+				v128::storeu(gv_unpacklo16(hi0, hi1), dst + x * 4, 2);
+				v128::storeu(gv_unpackhi16(hi0, hi1), dst + x * 4, 3);
+			}
+#endif
+
+			for (; x < width; x++)
+			{
+				const s32 ys = (y[x] - c.y_off) * c.y;
+				const s32 us = u[x / 2] - 128;
+				const s32 vs = v[x / 2] - 128;
+
+				const u8 r = yuv_clamp(ys + vs * c.rv);
+				const u8 g = yuv_clamp(ys + us * c.gu + vs * c.gv);
+				const u8 b = yuv_clamp(ys + us * c.bu);
+
+				u8* out = dst + x * 4;
+
+				if (argb)
+				{
+					out[0] = alpha, out[1] = r, out[2] = g, out[3] = b;
+				}
+				else
+				{
+					out[0] = r, out[1] = g, out[2] = b, out[3] = alpha;
+				}
+			}
+		}
+	}
+
+	void convert_yuv420_to_rgba32(const yuv420_picture& src, u8* dst, u32 dst_pitch, u8 alpha, bool argb, bool bt709, bool full_range)
+	{
+		const yuv_coefs& c = s_yuv_coefs[full_range][bt709];
+
+		for (u32 row = 0; row < src.height; row++)
+		{
+			const usz uv_offset = usz{row / 2} * src.uv_pitch;
+			convert_yuv420_row(c, src.y + usz{row} * src.y_pitch, src.u + uv_offset, src.v + uv_offset, dst + usz{row} * dst_pitch, src.width, alpha, argb);
+		}
+	}
+
 	std::pair<bool, media_info> get_media_info(const std::string& path, s32 av_media_type)
 	{
 		media_info info{};
@@ -48,6 +48,20 @@ namespace utils
 
 	std::pair<bool, media_info> get_media_info(const std::string& path, s32 av_media_type);
 
+	struct yuv420_picture
+	{
+		const u8* y;
+		const u8* u;
+		const u8* v;
+		u32 y_pitch;
+		u32 uv_pitch;
+		u32 width;
+		u32 height;
+	};
+
+	// Convert planar YUV 4:2:0 to interleaved 32-bit RGBA (or ARGB) with constant alpha, without scaling
+	void convert_yuv420_to_rgba32(const yuv420_picture& src, u8* dst, u32 dst_pitch, u8 alpha, bool argb, bool bt709, bool full_range);
+
 	template <typename D>
 	void parse_metadata(D& dst, const utils::media_info& mi, const std::string& key, const std::string& def, usz max_length)
 	{
@@ -351,6 +351,16 @@ bool utils::has_clwb()
 #endif
 }
 
+bool utils::has_sha()
+{
+#if defined(ARCH_X64)
+	static const bool g_value = get_cpuid(0, 0)[0] >= 0x7 && (get_cpuid(7, 0)[1] & 0x20000000) == 0x20000000 && has_sse41();
+	return g_value;
+#else
+	return false;
+#endif
+}
+
 bool utils::has_invariant_tsc()
 {
 #if defined(ARCH_X64)